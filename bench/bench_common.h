@@ -0,0 +1,56 @@
+// Helpers shared by the host benchmarks: the random keymap every configuration is filled with,
+// and the wall-clock timers. Each benchmark is one translation unit, so they are defined here.
+#pragma once
+#include <array>
+#include <chrono>
+#include <random>
+#include "IKeybind.h"
+
+
+
+/// @brief Fills a keybind system with `NEvent_` bindings of 1 to `KbMax_` distinct keys.
+template < typename Keybind_, size_t NKey_, size_t NEvent_, size_t KbMax_ >
+void assignKeymap(Keybind_& kb_)
+{
+	using eState = IPushButton::eState;
+	std::mt19937 rng{ 42 };
+	const eState states[]{ eState::push, eState::hold, eState::rapid, eState::release };
+	for (size_t e{}; e != NEvent_; ++e) {
+		std::array<uint16_t, KbMax_> ids{};
+		const size_t n{ 1 + e % KbMax_ };
+		for (size_t i{}; i != n; ++i) {
+			bool unique{ false };
+			while (!unique) {
+				ids[i] = static_cast<uint16_t>(rng() % NKey_);
+				unique = true;
+				for (size_t j{}; j != i; ++j) { unique = unique and ids[j] != ids[i]; }
+			}
+		}
+		const eState state{ states[rng() % 4] };
+		switch (n) {
+		case 1: kb_.template assign<1>(e, { ids[0] }, state); break;
+		case 2: kb_.template assign<2>(e, { ids[0], ids[1] }, state); break;
+		case 3: kb_.template assign<3>(e, { ids[0], ids[1], ids[2] }, state); break;
+		default: kb_.template assign<4>(e, { ids[0], ids[1], ids[2], ids[3] }, state); break;
+		}
+	}
+}
+
+/// @brief Returns the wall-clock time `fn_()` takes, in milliseconds.
+template < typename Fn_ >
+double msOf(Fn_ fn_)
+{
+	const auto start{ std::chrono::steady_clock::now() };
+	fn_();
+	const auto stop{ std::chrono::steady_clock::now() };
+	return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+/// @brief Returns the wall-clock time `fn_()` takes per operation, in nanoseconds.
+///
+/// @param ops_ The number of operations `fn_()` runs.
+template < typename Fn_ >
+double nsPerOp(size_t ops_, Fn_ fn_)
+{
+	return msOf(fn_) * 1e6 / static_cast<double>(ops_);
+}
@@ -0,0 +1,124 @@
+// Host replay of recorded-style operator input in virtual time.
+// Generates a reproducible script of key edges (typing with held modifiers) and replays it through
+// IKeybindSim, which jumps from edge to edge instead of waiting for the wall clock. Each replay
+// is run twice; the checksums of the reported events must match, and the number of updates must
+// follow the edges rather than the poll period, or the program fails. Prints CSV on stdout:
+//
+//     keys,events,kbmax,virtual_s,edges,updates,fired,wall_ms,checksum
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "IKeybindSim.h"
+#include "bench_common.h"
+
+
+
+namespace {
+
+using eState = IPushButton::eState;
+
+const uint32_t Hour{ 3600u * 1000u };  // Virtual time units are milliseconds
+const uint32_t Poll_Period{ 5 };       // The loop period of the simulated firmware
+
+
+/// @brief Generates typing on random keys, sometimes with the first keys held as modifiers.
+/// Keys stay down for 30 to 180 ms; the edges are sorted by time.
+template < typename KeyEdge_ >
+std::vector<KeyEdge_> makeScript(size_t nkey_, size_t kbmax_, uint32_t duration_)
+{
+	using index_type = decltype(KeyEdge_::key_idx);
+	std::mt19937 rng{ 7 };
+	std::vector<KeyEdge_> script;
+	const size_t nmod{ kbmax_ > 1 ? kbmax_ - 1 : 0 };
+	uint32_t t{ 10 };
+	while (t < duration_ - 1000) {
+		const bool chord{ nmod and rng() % 4 == 0 };
+		const index_type mod{ static_cast<index_type>(chord ? rng() % nmod : 0) };
+		const index_type k{ static_cast<index_type>(nmod + rng() % (nkey_ - nmod)) };
+		if (chord) { script.push_back({ mod, true, t }); t += 40 + rng() % 100; }
+		script.push_back({ k, true, t });
+		t += 30 + rng() % 150;
+		script.push_back({ k, false, t });
+		if (chord) { t += 20 + rng() % 50; script.push_back({ mod, false, t }); }
+		t += 50 + rng() % 300;
+	}
+	return script;
+}
+
+
+/// @brief Counts the reported events and hashes them with their virtual time.
+template < typename Keybind_ >
+struct Tally
+{
+	const IKeybindSim<Keybind_>* sim;
+	size_t fired;
+	uint32_t checksum;
+	size_t updates;
+
+	void onEvent(const typename Keybind_::FiredEvent& event_)
+	{
+		++fired;
+		checksum = checksum * 31 + static_cast<uint32_t>(event_.event_idx) * 7 + sim->now();
+	}
+};
+
+/// @brief Replays `hours_` of input through one template configuration, twice.
+///
+/// @return False if the replays differ, or if the driver polled instead of skipping idle time.
+template < size_t NKey_, size_t NEvent_, size_t KbMax_ >
+bool runConfig(uint32_t hours_)
+{
+	static_assert(KbMax_ <= 4, "bench: assignKeymap() handles at most 4 keys per binding.");
+	using Keybind = IKeybind<NKey_, NEvent_, KbMax_>;
+	using Sim = IKeybindSim<Keybind>;
+
+	const uint32_t duration{ hours_ * Hour };
+	const std::vector<typename Keybind::KeyEdge> script{ makeScript<typename Keybind::KeyEdge>(NKey_, KbMax_, duration) };
+	Tally<Keybind> tally[2]{};
+	for (Tally<Keybind>& it : tally) {
+		std::array<IPushButton, NKey_> keys{};
+		for (size_t k{}; k != NKey_; ++k) { keys[k].id(static_cast<uint16_t>(k)); }
+		static Keybind kb(keys);  // Static: large configurations do not fit the stack
+		kb.clear();
+		for (size_t k{}; k != NKey_; ++k) { kb.getKey(k).set(eState::idle, 0); }
+		assignKeymap<Keybind, NKey_, NEvent_, KbMax_>(kb);
+		kb.resolveTimeout(200);
+
+		Sim sim(kb, 0, Poll_Period);
+		it.sim = &sim;
+		for (size_t e{}; e != NEvent_; ++e) { kb.template onEvent<Tally<Keybind>, &Tally<Keybind>::onEvent>(e, it); }
+		sim.play(script.data(), script.size());
+		const double wall_ms{ msOf([&] { sim.runUntil(duration); }) };
+		for (size_t e{}; e != NEvent_; ++e) { kb.onEvent(e, nullptr); }
+		it.updates = sim.updateCount();
+		if (&it != &tally[0]) { continue; }
+		std::printf("%zu,%zu,%zu,%u,%zu,%zu,%zu,%.1f,", NKey_, NEvent_, KbMax_, duration / 1000,
+			script.size(), it.updates, it.fired, wall_ms);
+	}
+	std::printf("%08x\n", tally[0].checksum);
+	bool ok{ true };
+	if (tally[0].checksum != tally[1].checksum or tally[0].fired != tally[1].fired or tally[0].updates != tally[1].updates) {
+		std::fprintf(stderr, "%zu/%zu/%zu: replays differ\n", NKey_, NEvent_, KbMax_);
+		ok = false;
+	}
+	// Skipping idle time, the updates follow the edges; polling would update every Poll_Period
+	if (tally[0].updates > duration / Poll_Period / 10) {
+		std::fprintf(stderr, "%zu/%zu/%zu: %zu updates, the replay polled instead of skipping idle time\n",
+			NKey_, NEvent_, KbMax_, tally[0].updates);
+		ok = false;
+	}
+	return ok;
+}
+
+}  // namespace
+
+
+
+int main()
+{
+	std::printf("keys,events,kbmax,virtual_s,edges,updates,fired,wall_ms,checksum\n");
+	bool ok{ true };
+	ok = runConfig<16, 64, 3>(1) and ok;
+	ok = runConfig<64, 255, 4>(4) and ok;
+	return ok ? 0 : 1;
+}
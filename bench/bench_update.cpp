@@ -0,0 +1,170 @@
+// Host benchmark for IKeybind::update().
+// Builds keymaps of several sizes, drives the mock IPushButton with scripted input patterns
+// and prints the cost per call as CSV on stdout:
+//
+//     keys,events,kbmax,pattern,metric,ns_per_op,ops
+//
+// Metrics:
+//   update  One update() while the pattern is replayed (incremental detection).
+//   search  invalidate() + update() on a frozen pattern state, i.e. one full search of every bucket.
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "IKeybind.h"
+#include "bench_common.h"
+
+
+
+namespace {
+
+using eState = IPushButton::eState;
+
+/// @brief One scripted change of a key.
+struct Step
+{
+	uint16_t  key_idx;
+	eState    state;
+	uint32_t  push_time;
+};
+
+/// @brief A replayable input pattern: the key changes applied before each update().
+struct Script
+{
+	const char*                     name;
+	std::vector<Step>               init;   // Applied once before replaying
+	std::vector<std::vector<Step>>  cycle;  // Applied before each update()
+};
+
+const size_t Cycle_Count{ 1024 };
+const size_t Min_Ops{ 200000 };
+
+
+/// @brief No key ever changes.
+Script makeIdle(size_t)
+{
+	return Script{ "idle", {}, std::vector<std::vector<Step>>(Cycle_Count) };
+}
+
+/// @brief One key at a time is pushed, released and returns to idle.
+Script makeTaps(size_t nkey_)
+{
+	std::mt19937 rng{ 1 };
+	Script script{ "taps", {}, std::vector<std::vector<Step>>(Cycle_Count) };
+	uint16_t k{};
+	for (size_t c{}; c != Cycle_Count; ++c) {
+		const uint32_t t{ static_cast<uint32_t>(c) };
+		switch (c % 3) {
+		case 0: k = static_cast<uint16_t>(rng() % nkey_); script.cycle[c].push_back({ k, eState::push, t }); break;
+		case 1: script.cycle[c].push_back({ k, eState::release, t }); break;
+		default: script.cycle[c].push_back({ k, eState::idle, t }); break;
+		}
+	}
+	return script;
+}
+
+/// @brief The first `kbmax_ - 1` keys are held as modifiers while other keys are tapped and repeated.
+Script makeChords(size_t nkey_, size_t kbmax_)
+{
+	std::mt19937 rng{ 2 };
+	Script script{ "chords", {}, std::vector<std::vector<Step>>(Cycle_Count) };
+	const size_t nmod{ kbmax_ > 1 ? kbmax_ - 1 : 0 };
+	for (size_t k{}; k != nmod; ++k) {
+		script.init.push_back({ static_cast<uint16_t>(k), eState::hold, static_cast<uint32_t>(k) });
+	}
+	uint16_t k{};
+	for (size_t c{}; c != Cycle_Count; ++c) {
+		const uint32_t t{ static_cast<uint32_t>(c + nmod) };
+		switch (c % 4) {
+		case 0: k = static_cast<uint16_t>(nmod + rng() % (nkey_ - nmod)); script.cycle[c].push_back({ k, eState::push, t }); break;
+		case 1: script.cycle[c].push_back({ k, eState::rapid, t }); break;
+		case 2: script.cycle[c].push_back({ k, eState::release, t }); break;
+		default: script.cycle[c].push_back({ k, eState::idle, t }); break;
+		}
+	}
+	return script;
+}
+
+/// @brief Every key is held; one key at a time toggles between rapid and hold.
+Script makeAllHeld(size_t nkey_)
+{
+	std::mt19937 rng{ 3 };
+	Script script{ "all_held", {}, std::vector<std::vector<Step>>(Cycle_Count) };
+	for (size_t k{}; k != nkey_; ++k) {
+		script.init.push_back({ static_cast<uint16_t>(k), eState::hold, static_cast<uint32_t>(k) });
+	}
+	for (size_t c{}; c != Cycle_Count; ++c) {
+		const uint16_t k{ static_cast<uint16_t>(rng() % nkey_) };
+		script.cycle[c].push_back({ k, (c & 1) ? eState::hold : eState::rapid, static_cast<uint32_t>(k) });
+	}
+	return script;
+}
+
+
+
+template < typename Keybind_ >
+void apply(Keybind_& kb_, const std::vector<Step>& steps_)
+{
+	for (const Step& it : steps_) { kb_.getKey(it.key_idx).set(it.state, it.push_time); }
+}
+
+/// @brief Runs every pattern and metric for one template configuration.
+template < size_t NKey_, size_t NEvent_, size_t KbMax_ >
+void runConfig()
+{
+	static_assert(KbMax_ <= 4, "bench: assignKeymap() handles at most 4 keys per binding.");
+	using Keybind = IKeybind<NKey_, NEvent_, KbMax_>;
+
+	const Script scripts[]{ makeIdle(NKey_), makeTaps(NKey_), makeChords(NKey_, KbMax_), makeAllHeld(NKey_) };
+	for (const Script& script : scripts) {
+		std::array<IPushButton, NKey_> keys{};
+		for (size_t k{}; k != NKey_; ++k) { keys[k].id(static_cast<uint16_t>(k)); }
+		static Keybind kb(keys);  // Static: large configurations do not fit the stack
+		kb.clear();
+		for (size_t k{}; k != NKey_; ++k) { kb.getKey(k).set(eState::idle, 0); }
+		assignKeymap<Keybind, NKey_, NEvent_, KbMax_>(kb);
+		apply(kb, script.init);
+		kb.update();
+
+		// Replay the pattern
+		const size_t rounds{ (Min_Ops + Cycle_Count - 1) / Cycle_Count };
+		for (const auto& it : script.cycle) { apply(kb, it); kb.update(); }  // Warm-up
+		size_t fired{};
+		const double update_ns{ nsPerOp(rounds * Cycle_Count, [&] {
+			for (size_t r{}; r != rounds; ++r) {
+				for (const auto& it : script.cycle) {
+					apply(kb, it);
+					kb.update();
+					fired += kb.isAnyEvent();
+				}
+			}
+		}) };
+
+		// Full search on the frozen state
+		const double search_ns{ nsPerOp(Min_Ops, [&] {
+			for (size_t i{}; i != Min_Ops; ++i) {
+				kb.invalidate();
+				kb.update();
+				fired += kb.isAnyEvent();
+			}
+		}) };
+
+		std::printf("%zu,%zu,%zu,%s,update,%.2f,%zu\n", NKey_, NEvent_, KbMax_, script.name, update_ns, rounds * Cycle_Count);
+		std::printf("%zu,%zu,%zu,%s,search,%.2f,%zu\n", NKey_, NEvent_, KbMax_, script.name, search_ns, Min_Ops);
+		std::fprintf(stderr, "%zu/%zu/%zu %s: %zu update cycles reported events\n", NKey_, NEvent_, KbMax_, script.name, fired);
+	}
+}
+
+}  // namespace
+
+
+
+int main()
+{
+	std::printf("keys,events,kbmax,pattern,metric,ns_per_op,ops\n");
+	runConfig<8, 16, 2>();
+	runConfig<16, 64, 3>();
+	runConfig<32, 128, 4>();
+	runConfig<64, 255, 4>();
+	runConfig<400, 1000, 4>();
+	return 0;
+}
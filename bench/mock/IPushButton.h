@@ -0,0 +1,86 @@
+#pragma once
+#include <stdint.h> // For uint8_t, uint16_t, uint32_t
+
+
+
+//=== Scriptable host stand-in for the Arduino IPushButton ===//
+/// @brief Provides the part of the `IPushButton` interface that `IKeybind` uses.
+/// Nothing is read from hardware: `state()`, `pushTime()` and `id()` return whatever the
+/// benchmark (or test) script set last, directly or with `edge()`. Like the real button, a
+/// release lasts one update: the second `update()` that sees it makes the button idle.
+/// Nothing else changes on its own, so only a released button reports a `deadline()`.
+/// IDs are 16 bits wide, unlike pin numbers, so benchmarks can have more than 256 buttons.
+class IPushButton
+{
+public:
+	/// @brief Button states as bit flags, so they can be combined and tested with `&`.
+	enum eState : uint8_t
+	{
+		none     = 0,
+		idle     = 1 << 0,
+		push     = 1 << 1,
+		hold     = 1 << 2,
+		delay    = 1 << 3,
+		rapid    = 1 << 4,
+		release  = 1 << 5,
+	};
+
+
+private:
+	uint16_t  nId;        // Pin number on the real button
+	eState    eCurrent;   // State returned by state()
+	uint32_t  nPushTime;  // Time returned by pushTime()
+	bool      bReleased;  // True if an update() saw the release; the next one makes the button idle
+
+
+public:
+	/// @brief Constructor with the same signature as the Arduino class.
+	///
+	/// @param id_ The ID (pin number) of the button.
+	/// @param mode_ Ignored; the pin mode of the real button.
+	IPushButton(uint16_t id_ = 0, uint8_t mode_ = 0) :
+		nId{ id_ },
+		eCurrent{ idle },
+		nPushTime{},
+		bReleased{ false }
+	{
+		(void)mode_;
+	}
+
+	// Interface used by IKeybind
+	uint16_t id() const { return nId; }
+	eState state() const { return eCurrent; }
+	uint32_t pushTime() const { return nPushTime; }
+	void update()
+	{
+		if (eCurrent != release) { return; }
+		if (bReleased) { eCurrent = idle; }
+		bReleased = !bReleased;
+	}
+	uint32_t deadline() const { return eCurrent == release ? nPushTime : 0xFFFFFFFFu; }  // Due at once, or never
+	void repeatDelay(uint16_t) {}
+
+	// Scripting interface
+	void id(uint16_t id_) { nId = id_; }
+	void state(eState state_)
+	{
+		eCurrent = state_;
+		bReleased = false;
+	}
+	void pushTime(uint32_t push_time_) { nPushTime = push_time_; }
+
+	/// @brief Sets the state and the push time at once.
+	void set(eState state_, uint32_t push_time_)
+	{
+		state(state_);
+		nPushTime = push_time_;
+	}
+
+	/// @brief Applies a raw edge, as queued by an interrupt: the button is pushed
+	/// at `time_` when it goes down, and released when it goes up.
+	void edge(bool level_, uint32_t time_)
+	{
+		if (level_) { set(push, time_); }
+		else { state(release); }
+	}
+};
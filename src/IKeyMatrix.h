@@ -0,0 +1,381 @@
+#pragma once
+#include <array>
+#include <stdexcept>
+#include <stdint.h> // For uint8_t
+#include "IKeybind.h"
+
+
+
+//=== Key matrix ports ===//
+// A port drives the rows of a key matrix and reads its columns as one word:
+//
+//     struct Port
+//     {
+//         using word_type = ...;             // One bit per column
+//         void selectRow(uint8_t row_);      // Drive a row
+//         void unselectRow(uint8_t row_);    // Release it again
+//         word_type readColumns();           // Bit c is set if the key at (row, c) is closed
+//     };
+
+/// @brief Simulated matrix port for host builds and tests.
+/// Switches are opened and closed by the test; `readColumns()` returns the closed
+/// switches of the selected row, like the column input register of a real port.
+///
+/// @tparam NRow_ The number of rows.
+/// @tparam NCol_ The number of columns, at most 32.
+template < uint8_t NRow_, uint8_t NCol_ >
+class IKeyMatrixPortSim
+{
+	static_assert(NCol_ > 0 and NCol_ <= 32, "IKeyMatrixPortSim: NCol must be in [1, 32].");
+
+public:
+	// Type aliases
+	using word_type = typename IKeybindBitset<NCol_>::word_type;
+
+
+private:
+	std::array<word_type, NRow_> aClosed;  // Row -> Closed switches
+	uint8_t nSelected;                     // Selected row, or NRow_ if none
+
+	static void checkSwitch(uint8_t row_, uint8_t col_, const char* what_)
+	{
+		if (row_ >= NRow_ or col_ >= NCol_) { throw std::out_of_range(what_); }
+	}
+
+
+public:
+	IKeyMatrixPortSim() :
+		aClosed{},
+		nSelected{ NRow_ }
+	{}
+
+	// Port interface
+	void selectRow(uint8_t row_) { nSelected = row_; }
+	void unselectRow(uint8_t) { nSelected = NRow_; }
+	word_type readColumns() const { return (nSelected < NRow_) ? aClosed[nSelected] : word_type(0); }
+
+	// Simulation interface
+	/// @throw std::out_of_range If `row_` or `col_` is out of bounds.
+	void press(uint8_t row_, uint8_t col_)
+	{
+		checkSwitch(row_, col_, "IKeyMatrixPortSim::press: Row or column is out of range.");
+		aClosed[row_] |= static_cast<word_type>(word_type(1) << col_);
+	}
+
+	/// @throw std::out_of_range If `row_` or `col_` is out of bounds.
+	void release(uint8_t row_, uint8_t col_)
+	{
+		checkSwitch(row_, col_, "IKeyMatrixPortSim::release: Row or column is out of range.");
+		aClosed[row_] &= static_cast<word_type>(~(word_type(1) << col_));
+	}
+
+	/// @brief Sets all switches of a row at once; bit c closes the switch in column c.
+	void setRow(uint8_t row_, word_type closed_) { aClosed[row_] = closed_; }
+};
+
+
+#if defined(__AVR__)
+/// @brief Matrix port on AVR I/O registers: rows on one port, columns on another.
+/// A selected row is driven low, the other rows float; the columns use the internal
+/// pull-ups, so a closed switch reads low. All columns are read with one register access.
+///
+/// @tparam NRow_ The number of rows, on consecutive pins of the row port.
+/// @tparam NCol_ The number of columns, on consecutive pins of the column port.
+template < uint8_t NRow_, uint8_t NCol_ >
+class IKeyMatrixPortAvr
+{
+	static_assert(NRow_ > 0 and NRow_ <= 8 and NCol_ > 0 and NCol_ <= 8, "IKeyMatrixPortAvr: Rows and columns must fit one port.");
+
+public:
+	// Type aliases
+	using word_type = uint8_t;
+
+
+private:
+	volatile uint8_t& rRowDdr;
+	volatile uint8_t& rRowPort;
+	volatile uint8_t& rColPin;
+	uint8_t nRowShift;  // Pin of row 0
+	uint8_t nColShift;  // Pin of column 0
+
+
+public:
+	/// @brief Configures the rows as floating inputs and the columns as inputs with pull-up.
+	///
+	///     IKeyMatrixPortAvr<4, 6> port(DDRB, PORTB, DDRD, PORTD, PIND, 0, 2);
+	IKeyMatrixPortAvr(volatile uint8_t& row_ddr_, volatile uint8_t& row_port_,
+		volatile uint8_t& col_ddr_, volatile uint8_t& col_port_, volatile uint8_t& col_pin_,
+		uint8_t row_shift_ = 0, uint8_t col_shift_ = 0) :
+		rRowDdr{ row_ddr_ },
+		rRowPort{ row_port_ },
+		rColPin{ col_pin_ },
+		nRowShift{ row_shift_ },
+		nColShift{ col_shift_ }
+	{
+		const uint8_t row_mask{ static_cast<uint8_t>(((1u << NRow_) - 1) << nRowShift) };
+		const uint8_t col_mask{ static_cast<uint8_t>(((1u << NCol_) - 1) << nColShift) };
+		rRowDdr &= static_cast<uint8_t>(~row_mask);
+		rRowPort &= static_cast<uint8_t>(~row_mask);
+		col_ddr_ &= static_cast<uint8_t>(~col_mask);
+		col_port_ |= col_mask;
+	}
+
+	// Port interface
+	void selectRow(uint8_t row_) { rRowDdr |= static_cast<uint8_t>(1u << (row_ + nRowShift)); }
+	void unselectRow(uint8_t row_) { rRowDdr &= static_cast<uint8_t>(~(1u << (row_ + nRowShift))); }
+	word_type readColumns() const
+	{
+		__asm__ __volatile__("nop\n\tnop");  // Let the row settle
+		return static_cast<word_type>((~rColPin >> nColShift) & ((1u << NCol_) - 1));
+	}
+};
+#endif
+
+
+
+//=== Key matrix scanner ===//
+/// @brief A key of a scanned matrix, updated in bulk by `IKeyMatrix::scan()`.
+/// Provides the part of the `IPushButton` interface read by the keybind engine, in 8 bytes
+/// instead of a full button object. `update()` does nothing, the matrix scan updates the key.
+class IKeyMatrixKey
+{
+	template <typename, uint8_t, uint8_t, uint8_t> friend class IKeyMatrix;
+
+public:
+	// Type aliases
+	using eState = IPushButton::eState;
+
+
+private:
+	uint16_t  nId;        // Key ID: row * columns + column
+	eState    eCurrent;   // Current state
+	uint32_t  nPushTime;  // Time of the last push
+
+
+public:
+	IKeyMatrixKey() :
+		nId{},
+		eCurrent{ eState::idle },
+		nPushTime{}
+	{}
+
+	uint16_t id() const { return nId; }
+	eState state() const { return eCurrent; }
+	uint32_t pushTime() const { return nPushTime; }
+	void update() {}
+};
+
+
+/// @brief Scans a key matrix and derives the key states in bulk.
+/// Each scan drives the rows one at a time and reads all columns of a row as one word into
+/// a raw key bitset, which `IKeybindDebounce` debounces a word of keys at a time. Presses,
+/// releases and hold thresholds are then found from the changed levels, so only keys that
+/// actually change are visited. States follow `IPushButton`: push, then hold after the hold
+/// time, release, then idle.
+///
+/// @tparam Port_ The port type, see `IKeyMatrixPortSim`.
+/// @tparam NRow_ The number of rows.
+/// @tparam NCol_ The number of columns.
+/// @tparam DebounceBits_ The debounce counter width; a level must be read `2^DebounceBits_` scans in a row.
+template < typename Port_, uint8_t NRow_, uint8_t NCol_, uint8_t DebounceBits_ = 2 >
+class IKeyMatrix
+{
+	static_assert(NRow_ > 0 and NCol_ > 0, "IKeyMatrix: The matrix must not be empty.");
+	static_assert(NCol_ <= 32, "IKeyMatrix: NCol must be at most 32.");
+
+public:
+	// Type aliases
+	using self_type  = IKeyMatrix;
+	using Key        = IKeyMatrixKey;
+	using eState     = IKeyMatrixKey::eState;
+
+public:
+	// Compile-time constants
+	static const uint8_t Row_Count{ NRow_ };
+	static const uint8_t Col_Count{ NCol_ };
+	static const uint16_t Key_Count{ NRow_ * NCol_ };
+	static const uint32_t Col_Mask{ ~uint32_t(0) >> (32 - NCol_) };  // The bits of `readColumns()` that are columns
+
+	using debounce_type  = IKeybindDebounce<Key_Count, DebounceBits_>;
+	using key_mask       = typename debounce_type::key_mask;
+
+
+private:
+	/// @brief The port the matrix is wired to; not owned.
+	Port_& rPort;
+
+	/// @brief The keys, in row-major order (index = row * columns + column).
+	std::array<Key, Key_Count> aKey;
+
+	/// @brief Debounces the raw samples into stable levels.
+	debounce_type oDebounce;
+
+	/// @brief Keys pushed and not yet held.
+	key_mask aPushed;
+
+	/// @brief Keys released by the previous scan; they become idle with this one.
+	key_mask aReleased;
+
+	/// @brief Time a key must stay down to change from push to hold.
+	uint32_t nHoldTime;
+
+
+public:
+	/// @brief Constructor for IKeyMatrix.
+	///
+	/// @param port_ The port the matrix is wired to. It must outlive the matrix.
+	/// @param hold_time_ Time a key must stay down to be held, in `scan()` time units.
+	explicit IKeyMatrix(Port_& port_, uint32_t hold_time_ = 500) :
+		rPort{ port_ },
+		aKey{},
+		oDebounce{},
+		aPushed{},
+		aReleased{},
+		nHoldTime{ hold_time_ }
+	{
+		for (uint16_t i{}; i != Key_Count; ++i) { aKey[i].nId = i; }
+	}
+
+	/// @brief Scans the matrix and updates the key states.
+	///
+	/// @param now_ The current time (e.g. `millis()`).
+	/// @return The keys whose state changed.
+	key_mask scan(uint32_t now_)
+	{
+		// Read every row as one word
+		key_mask raw;
+		for (uint8_t r{}; r != NRow_; ++r) {
+			rPort.selectRow(r);
+			// Ports may return more bits than columns (e.g. a whole PIN register); those are not keys
+			uint32_t cols{ static_cast<uint32_t>(rPort.readColumns()) & Col_Mask };
+			rPort.unselectRow(r);
+			for (; cols; cols &= cols - 1) { raw.set(r * NCol_ + __builtin_ctzl(cols)); }
+		}
+		const key_mask toggled{ oDebounce.sample(raw) };
+		const key_mask& stable{ oDebounce.stable() };
+		key_mask changed;
+
+		// Keys released by the previous scan become idle
+		for (size_t i{ aReleased.findNext(0) }; i != Key_Count; i = aReleased.findNext(i +1)) {
+			aKey[i].eCurrent = eState::idle;
+			changed.set(i);
+		}
+		aReleased.reset();
+
+		// Pushed keys become held
+		for (size_t i{ aPushed.findNext(0) }; i != Key_Count; i = aPushed.findNext(i +1)) {
+			if (now_ - aKey[i].nPushTime < nHoldTime) { continue; }
+			aKey[i].eCurrent = eState::hold;
+			aPushed.reset(i);
+			changed.set(i);
+		}
+
+		for (size_t i{ toggled.findNext(0) }; i != Key_Count; i = toggled.findNext(i +1)) {
+			if (stable.test(i)) {
+				aKey[i].eCurrent = eState::push;
+				aKey[i].nPushTime = now_;
+				aPushed.set(i);
+			}
+			else {
+				aKey[i].eCurrent = eState::release;
+				aPushed.reset(i);
+				aReleased.set(i);
+			}
+			changed.set(i);
+		}
+		return changed;
+	}
+
+	/// @brief Returns the debounced levels of all keys.
+	const key_mask& levels() const { return oDebounce.stable(); }
+
+	/// @brief Gives the keybind engine access to the keys.
+	std::array<Key, Key_Count>& keys() { return aKey; }
+	const std::array<Key, Key_Count>& keys() const { return aKey; }
+
+	/// @brief Sets the time a key must stay down to be held.
+	void holdTime(uint32_t hold_time_) { nHoldTime = hold_time_; }
+};
+
+
+
+/// @brief A keybind system fed by a scanned key matrix.
+/// The matrix keys replace per-pin `IPushButton` objects: `update(now)` scans the matrix and
+/// hands the keys that changed to the engine, which only visits those and the active keys.
+/// Key IDs are `row * columns + column`.
+///
+/// @tparam Port_ The port type, see `IKeyMatrixPortSim`.
+/// @tparam NRow_ The number of rows.
+/// @tparam NCol_ The number of columns.
+/// @tparam NEvent_ The maximum number of distinct keybind events that can be defined.
+/// @tparam KbMax_ The maximum number of keys that can be part of a single keybind sequence. Every
+/// event reserves this many key slots, so keep it to the longest binding (e.g. 4), not the key count.
+/// @tparam DebounceBits_ The debounce counter width, see `IKeyMatrix`.
+template < typename Port_, uint8_t NRow_, uint8_t NCol_, size_t NEvent_, size_t KbMax_, uint8_t DebounceBits_ = 2 >
+class IKeybindMatrix final : public IKeybindCore<IKeybindMatrix<Port_, NRow_, NCol_, NEvent_, KbMax_, DebounceBits_>,
+	NRow_ * NCol_, NEvent_, KbMax_, IKeyMatrixKey>,
+	public IKeybindKeymapOwner<IKeymap<NRow_ * NCol_, NEvent_, KbMax_>>
+{
+public:
+	// Type aliases
+	using self_type   = IKeybindMatrix;
+	using base_type   = IKeybindCore<IKeybindMatrix, NRow_ * NCol_, NEvent_, KbMax_, IKeyMatrixKey>;
+	using keymap_base = IKeybindKeymapOwner<typename base_type::keymap_type>;
+	using matrix_type = IKeyMatrix<Port_, NRow_, NCol_, DebounceBits_>;
+	using Key         = typename base_type::Key;
+	using keymap_type = typename base_type::keymap_type;
+
+	friend base_type;
+
+
+private:
+	/// @brief The matrix scanner, which owns the keys.
+	matrix_type oMatrix;
+
+	/// @brief Provides the keys to `IKeybindCore`; the keymap comes from `IKeybindKeymapOwner`.
+	std::array<Key, NRow_ * NCol_>& keyArray() { return oMatrix.keys(); }
+	const std::array<Key, NRow_ * NCol_>& keyArray() const { return oMatrix.keys(); }
+
+
+public:
+	// Default destructor
+	~IKeybindMatrix() = default;
+
+	/// @brief Constructor for IKeybindMatrix.
+	///
+	/// @param port_ The port the matrix is wired to. It must outlive the keybind system.
+	/// @param hold_time_ Time a key must stay down to be held, in `update()` time units.
+	explicit IKeybindMatrix(Port_& port_, uint32_t hold_time_ = 500) :
+		base_type(),
+		keymap_base(),
+		oMatrix{ port_, hold_time_ }
+	{
+		this->indexKeyIds();
+		this->updateKeys(false);  // The scan updates the keys
+	}
+
+	/// @brief Scans the matrix and detects keybind events.
+	///
+	/// @param now_ The current time (e.g. `millis()`).
+	void update(uint32_t now_)
+	{
+		this->wakeKeys(oMatrix.scan(now_));
+		base_type::update();
+	}
+
+	/// @brief Scans the matrix at the time of the `clock()`, so the hold times and the keybind
+	/// timeouts follow one time source (e.g. a virtual clock in host simulations).
+	///
+	/// @throw std::logic_error If no `clock()` is set.
+	void update()
+	{
+		if (!this->hasClock()) {
+			throw std::logic_error(
+				"IKeybindMatrix::update: No clock set.");
+		}
+		update(this->readClock());
+	}
+
+	/// @brief Gets the matrix scanner, e.g. to read the debounced levels.
+	matrix_type& matrix() { return oMatrix; }
+};
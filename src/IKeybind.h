@@ -2,332 +2,3468 @@
 #include <array>
 #include <stdexcept>
 #include <stdint.h> // For uint8_t
+#include <type_traits> // For std::conditional
+#include <utility> // For std::declval
+#include <initializer_list>
 #include "IPushButton.h" // Arduino-specific IPushButton class
+#if defined(__AVR__)
+#include <avr/pgmspace.h> // For memcpy_P
+#else
+#include <atomic>
+#endif
 
 
+// Keymaps are built at compile time from C++17 on (mutating std::array is constexpr there)
+#if __cplusplus >= 201703L
+#define IKEYBIND_CONSTEXPR constexpr
+#else
+#define IKEYBIND_CONSTEXPR
+#endif
 
-//=== Base interface for keybinding logic ===//
-class IKeybindBase
-{
-public:
-	// Type aliases
-	using self_type  = IKeybindBase;
-	using size_type  = uint8_t;
-	using Key        = IPushButton;
-	using eState     = IPushButton::eState;
 
-public:
-	// Virtual destructor
-	virtual ~IKeybindBase() = default;
-	// Updates the state of all keys and checks for triggered keybind events
-	virtual void update() = 0;
-	// Checks if a specific keybind event has occurred
-	virtual bool isEvent(uint8_t) const = 0;
-	// Checks if any keybind event has occurred
-	virtual bool isAnyEvent() const = 0;
-};
 
+//=== Index types ===//
+/// @brief The smallest unsigned type that holds every value from 0 to `N`.
+/// Keeps the indexes of small keybind systems at 8 bits and widens them only where needed.
+template < uint32_t N >
+using IKeybindUint = typename std::conditional< (N <= 0xFF), uint8_t,
+                     typename std::conditional< (N <= 0xFFFF), uint16_t, uint32_t >::type >::type;
 
 
-/// @brief A templated class for managing and detecting complex keybinds.
-/// This class extends IKeybindBase and provides a robust mechanism to define
-/// and detect sequences of key presses (keybinds) involving multiple keys and specific states.
-/// It is designed to be highly configurable through its template parameters.
+
+//=== Word-packed fixed-size bitset ===//
+/// @brief A minimal bitset that packs `N` flags into machine words.
+/// The word type is the smallest of `uint8_t`, `uint16_t` or `uint32_t` that holds all
+/// flags, or `uint32_t` if more words are needed. Clearing, `any()` and `findNext()`
+/// work a whole word at a time.
 ///
-/// @tparam NKey_ The maximum number of individual keys this keybind system can manage.
-/// @tparam NEvent_ The maximum number of distinct keybind events that can be defined.
-/// @tparam KbMax_ The maximum number of keys that can be part of a single keybind sequence.
-template < uint8_t NKey_, uint8_t NEvent_, uint8_t KbMax_ = NKey_ >
-class IKeybind : public IKeybindBase
+/// @tparam N The number of flags.
+template < size_t N >
+class IKeybindBitset
 {
 public:
 	// Type aliases
-	using self_type  = IKeybind;
-	using base_type  = IKeybindBase;
-	using size_type  = uint8_t;
-	using Key        = typename base_type::Key;
-	using eState     = typename base_type::eState;
-
+	using self_type  = IKeybindBitset;
+	using word_type  = typename std::conditional< (N <= 8), uint8_t,
+	                   typename std::conditional< (N <= 16), uint16_t, uint32_t >::type >::type;
 
 public:
 	// Compile-time constants
-	static const size_type Key_Count{ NKey_ };
-	static const size_type Event_Count{ NEvent_ };
-	static const size_type Keybind_Max{ KbMax_ };
+	static const size_t Bit_Count{ N };
+	static const size_t Word_Bits{ sizeof(word_type) * 8 };
+	static const size_t Word_Count{ (N + Word_Bits - 1) / Word_Bits };
 
 
 private:
-	/// @brief  An array holding all the individual key objects.
-	std::array<Key, Key_Count> aKey;
+	/// @brief The packed flags; bit `i % Word_Bits` of word `i / Word_Bits` is flag `i`.
+	std::array<word_type, Word_Count> aWord;
 
-	/// @brief A 2D array storing the key indices for each defined keybind event.
-	/// `aKeybind[event_idx][key_in_sequence_idx]` stores the index of the key in `aKey`.
- 	std::array<std::array<size_type, Keybind_Max>, Event_Count> aKeybind;
 
-	/// @brief An array storing the actual number of keys in each defined keybind.
-	/// `aKeybindSize[event_idx]` holds the size of the keybind at `event_idx`.
-	std::array<size_type, Event_Count> aKeybindSize;
+public:
+	IKEYBIND_CONSTEXPR IKeybindBitset() :
+		aWord{}
+	{}
 
-	/// @brief An array storing the required state for the primary key of each event.
-	/// `aPrimaryKeyState[event_idx]` specifies the `eState` that the final key
-	/// in the keybind sequence (the primary key) must be in for the event to trigger.
-	std::array<eState, Event_Count> aPrimaryKeyState;
+	/// @brief Returns the flag at `idx_`.
+	IKEYBIND_CONSTEXPR bool test(size_t idx_) const
+	{
+		return (aWord[idx_ / Word_Bits] >> (idx_ % Word_Bits)) & 1u;
+	}
 
-	/// @brief A boolean array indicating whether each event has occurred in the current update cycle.
-	/// `aEventOccurred[event_idx]` is true if the keybind for that event was detected.
-	std::array<bool, Event_Count> aEventOccurred;
+	/// @brief Sets the flag at `idx_`.
+	IKEYBIND_CONSTEXPR void set(size_t idx_)
+	{
+		aWord[idx_ / Word_Bits] |= static_cast<word_type>(word_type(1) << (idx_ % Word_Bits));
+	}
 
-	/// @brief A boolean array tracking if a key has been used as a modifier in a detected keybind.
-	/// `aUsedAsModifier[key_idx]` is true if the key at `key_idx` was part of a
-	/// successfully detected keybind as a modifier (not the primary key).
-	std::array<bool, Key_Count> aUsedAsModifier;
+	/// @brief Clears the flag at `idx_`.
+	IKEYBIND_CONSTEXPR void reset(size_t idx_)
+	{
+		aWord[idx_ / Word_Bits] &= static_cast<word_type>(~(word_type(1) << (idx_ % Word_Bits)));
+	}
 
+	/// @brief Clears all flags.
+	void reset()
+	{
+		aWord.fill(0);
+	}
 
-private:
-	// Deleted constructors
-	IKeybind(const self_type&) = delete;
-	IKeybind(self_type&&) = delete;
+	/// @brief Sets all flags.
+	void set()
+	{
+		aWord.fill(static_cast<word_type>(~word_type(0)));
+		if (N % Word_Bits) {
+			aWord[Word_Count - 1] = static_cast<word_type>((word_type(1) << (N % Word_Bits)) - 1);
+		}
+	}
 
-	/// @brief Checks if all keys in a given keybind sequence are in the correct state and timing.
-	/// This method ensures that modifier keys are held (pushed, held, or delayed) and
-	/// that their push times are in the correct sequence relative to the primary key.
-	///
-	/// @param event_idx_ The index of the keybind event to validate.
-	/// @return True if the sequence is valid, false otherwise.
-	bool isValidSequence(size_type event_idx_) const
+	/// @brief Returns true if at least one flag is set.
+	bool any() const
+	{
+		for (auto& it : aWord) { if (it) { return true; } }
+		return false;
+	}
+
+	/// @brief Sets every flag that is set in `other_`.
+	IKEYBIND_CONSTEXPR self_type& operator|=(const self_type& other_)
+	{
+		for (size_t w{}; w != Word_Count; ++w) { aWord[w] |= other_.aWord[w]; }
+		return *this;
+	}
+
+	/// @brief Returns true if every flag set in `other_` is also set in this bitset.
+	/// Evaluates `(this & other_) == other_` one word at a time.
+	IKEYBIND_CONSTEXPR bool includes(const self_type& other_) const
 	{
-		for (size_type j{ 1 }; j < aKeybindSize[event_idx_]; ++j) {
-			if (!(aKey[aKeybind[event_idx_][j]].state() & (eState::push | eState::hold | eState::delay))) { return false; }
-			if (aKey[aKeybind[event_idx_][j]].pushTime() > aKey[aKeybind[event_idx_][j - 1]].pushTime()) { return false; }
+		for (size_t w{}; w != Word_Count; ++w) {
+			if ((aWord[w] & other_.aWord[w]) != other_.aWord[w]) { return false; }
 		}
-		return (aKey[aKeybind[event_idx_][0]].state() != eState::none);
+		return true;
 	}
 
-	/// @brief Checks if a specific key has been marked as a modifier in a detected keybind.
+	/// @brief Finds the first set flag at or after `idx_`.
 	///
-	/// @param key_idx_ The index of the key to check.
-	/// @return True if the key is used as a modifier, false otherwise.
-	bool isUsedAsModifier(size_type key_idx_) const
+	/// @param idx_ The index to start searching from.
+	/// @return The index of the next set flag, or `N` if there is none.
+	size_t findNext(size_t idx_) const
+	{
+		if (idx_ >= N) { return N; }
+		size_t w{ idx_ / Word_Bits };
+		uint32_t bits{ static_cast<uint32_t>(aWord[w] >> (idx_ % Word_Bits)) };
+		if (bits) { return idx_ + __builtin_ctzl(bits); }
+		while (++w != Word_Count) {
+			if (aWord[w]) { return w * Word_Bits + __builtin_ctzl(aWord[w]); }
+		}
+		return N;
+	}
+
+	/// @brief Direct access to the packed words.
+	const std::array<word_type, Word_Count>& words() const
 	{
-		return (aUsedAsModifier[key_idx_]);
+		return aWord;
 	}
+	std::array<word_type, Word_Count>& words()
+	{
+		return aWord;
+	}
+};
+
+
+
+//=== Bit-sliced debounce ===//
+/// @brief Debounces many keys at once with vertical counters.
+/// Every key has a `Bits_`-bit counter of consecutive samples that differ from its stable level.
+/// The counters are stored bit-sliced: word `b` of `aCount` holds bit `b` of the counters of a whole
+/// word of keys, so one sample of up to 32 keys is debounced by a few word operations without any
+/// per-key branch. A key takes over a new level after `2^Bits_` consecutive samples agree on it;
+/// a sample that matches the stable level resets its counter.
+///
+/// @tparam N The number of keys.
+/// @tparam Bits_ The width of the counters, 1 to 4 (2 to 16 samples).
+template < size_t N, uint8_t Bits_ = 2 >
+class IKeybindDebounce
+{
+	static_assert(Bits_ >= 1 and Bits_ <= 4, "IKeybindDebounce: Bits must be in [1, 4].");
 
-	/// @brief Checks if a keybind at a given event index is empty (not assigned).
+public:
+	// Type aliases
+	using key_mask   = IKeybindBitset<N>;
+	using word_type  = typename key_mask::word_type;
+
+public:
+	// Compile-time constants
+	static const uint8_t Sample_Count{ 1u << Bits_ };
+
+
+private:
+	/// @brief The debounced levels.
+	key_mask oStable;
+
+	/// @brief The bit-sliced counters: `aCount[b][w]` holds bit `b` of the counters of word `w`.
+	std::array<std::array<word_type, key_mask::Word_Count>, Bits_> aCount;
+
+
+public:
+	IKeybindDebounce() :
+		oStable{},
+		aCount{}
+	{}
+
+	/// @brief Debounces one sample of a word of keys.
 	///
-	/// @param event_idx_ The index of the event to check.
-	/// @return True if the keybind is empty, false otherwise.
-	bool isEmptyKeybind(size_type event_idx_) const
+	/// @param word_idx_ The index of the word (keys `word_idx_ * Word_Bits` and up).
+	/// @param raw_ The sampled levels of these keys.
+	/// @return The keys of the word whose stable level changed.
+	word_type sample(size_t word_idx_, word_type raw_)
 	{
-		return (aKeybindSize[event_idx_] == 0);
+		word_type& stable{ oStable.words()[word_idx_] };
+		const word_type delta{ static_cast<word_type>(raw_ ^ stable) };
+		word_type carry{ delta };  // Increments the counters that differ, clears the others
+		for (auto& it : aCount) {
+			word_type& bit{ it[word_idx_] };
+			const word_type next{ static_cast<word_type>((bit ^ carry) & delta) };
+			carry = static_cast<word_type>(bit & carry);
+			bit = next;
+		}
+		stable ^= carry;  // Counters that wrapped around
+		return carry;
 	}
 
-	/// @brief Marks all modifier keys within a successfully detected keybind as 'used'.
-	/// This prevents these modifier keys from also being detected as primary keys
-	/// for other keybinds in the same update cycle.
+	/// @brief Debounces one sample of all keys.
 	///
-	/// @param event_idx_ The index of the event whose modifiers should be marked.
-	void markModifiersAsUsed(size_type event_idx_)
+	/// @param raw_ The sampled levels.
+	/// @return The keys whose stable level changed.
+	key_mask sample(const key_mask& raw_)
 	{
-		for (size_type j{ 1 }; j < aKeybindSize[event_idx_]; ++j) {
-			aUsedAsModifier[aKeybind[event_idx_][j]] = true;
+		key_mask toggled;
+		for (size_t w{}; w != key_mask::Word_Count; ++w) {
+			toggled.words()[w] = sample(w, raw_.words()[w]);
 		}
+		return toggled;
 	}
 
-	/// @brief Core logic for searching and identifying triggered keybind events.
-	/// This method iterates through all defined keybinds, validates their sequences,
-	/// and marks which events have occurred. It prioritizes longer keybind sequences
-	/// if multiple keybinds share the same primary key.
-	void searchKeybind()
+	/// @brief Returns the debounced levels.
+	const key_mask& stable() const { return oStable; }
+
+	/// @brief Forgets all samples and sets every stable level low.
+	void reset()
 	{
-		// Primary key index -> Index of the longest event using this key as primary
-		std::array<size_type, Key_Count> aKeyBestEventIdx{};  // Stores (event_index +1), so 0 means "no event found yet"
+		oStable.reset();
+		for (auto& it : aCount) { it.fill(0); }
+	}
+};
 
-		// Iterate through all defined keybinds
-		for (size_type i{}; i != Event_Count; ++i) {
-			// Skip if the current keybind has not been assigned (is empty)
-			if (isEmptyKeybind(i)) {
-				continue;
-			}
-			// Prefer longest sequence for primary key
-			if (aKeyBestEventIdx[aKeybind[i][0]]) {
-				if (aKeybindSize[i] < aKeybindSize[aKeyBestEventIdx[aKeybind[i][0]] -1]) {
-					continue;
-				}
-				/*
-					CHANGES BEGIN
-				*/
-				if (aKeybindSize[i] == aKeybindSize[aKeyBestEventIdx[aKeybind[i][0]] -1]) {
-					if (!(aPrimaryKeyState[i] & aKey[aKeybind[i][0]].state())) {
-						continue;
-					}
-				}
-				/*
-					CHANGES END
-				*/
 
-			}
-			// Skip if primary key already used as modifier
-			if (isUsedAsModifier(aKeybind[i][0])) {
-				continue;
-			}
-			// Ensures all keys are in the correct state
-			if (!isValidSequence(i)) {
-				continue;
-			}
 
-			// If all checks pass, this keybind is a candidate
-			aKeyBestEventIdx[aKeybind[i][0]] = i +1;  // store its index (plus 1)
-		}
+//=== Variable shared between execution contexts ===//
+/// @brief A value written in one context (interrupt, thread, core) and read in another.
+/// Stores publish everything written before them to a context that loads the value.
+/// Uses `std::atomic` with release/acquire ordering; on AVR, which has no `<atomic>`,
+/// a `volatile` byte with compiler barriers (single byte loads and stores are atomic there).
+///
+/// @tparam T_ The type of the value.
+template < typename T_ >
+class IKeybindAtomic
+{
+#if defined(__AVR__)
+	static_assert(sizeof(T_) == 1, "IKeybindAtomic: Only single byte values are atomic on AVR.");
 
-		// After evaluating all keybinds, mark the best events as occurred and their modifiers as used
-		for (size_type i{}; i != Key_Count; ++i) {
-			// If no event was found for this primary key, skip
-			if (!aKeyBestEventIdx[i]) { continue; }
-			// Check primary key state
-			if (!(aPrimaryKeyState[aKeyBestEventIdx[i] -1] & aKey[i].state())) { continue; }
-			// Mark the modifiers of the detected event
-			markModifiersAsUsed(aKeyBestEventIdx[i] -1);
-			// Mark the event as occurred
-			aEventOccurred[aKeyBestEventIdx[i] -1] = true;
-		}
+private:
+	volatile T_ vValue;
+
+public:
+	explicit IKeybindAtomic(T_ value_ = T_{}) : vValue{ value_ } {}
+
+	T_ load() const
+	{
+		const T_ value{ vValue };
+		__asm__ __volatile__("" ::: "memory");
+		return value;
 	}
 
+	void store(T_ value_)
+	{
+		__asm__ __volatile__("" ::: "memory");
+		vValue = value_;
+	}
+#else
+private:
+	std::atomic<T_> vValue;
 
 public:
-	// Default destructor
-	~IKeybind() = default;
+	explicit IKeybindAtomic(T_ value_ = T_{}) : vValue{ value_ } {}
 
-	/// @brief Constructor for IKeybind.
-	/// Initializes the keybind system with an array of individual key objects.
-	/// All internal arrays for keybind definitions and states are default-initialized (filled with zeros/false).
-	///
-	/// @param keys_ An `std::array` containing all the `IPushButton` objects this keybind system will manage.
-	IKeybind(std::array<Key, Key_Count> keys_) :
-		aKey{ keys_ },       // Initialize the array of keys with the provided keys
-		aKeybind{},          // Default-initialize the keybind definitions array
-		aKeybindSize{},      // Default-initialize the keybind size array
-		aPrimaryKeyState{},  // Default-initialize the primary key state array
-		aEventOccurred{},    // Default-initialize the event occurrence array
-		aUsedAsModifier{}    // Default-initialize the used as modifier array
+	T_ load() const { return vValue.load(std::memory_order_acquire); }
+	void store(T_ value_) { vValue.store(value_, std::memory_order_release); }
+#endif
+};
+
+
+
+//=== Fixed-capacity ring buffer ===//
+/// @brief Allocation-free FIFO over caller-provided storage.
+/// The storage is supplied by `IKeybindRing`, so code that only pushes or pops
+/// (like `IKeybind`) does not depend on the capacity. When the buffer is full,
+/// new entries are dropped and counted as overflow.
+///
+/// @tparam Entry_ The type of the stored entries.
+template < typename Entry_ >
+class IKeybindRingBase
+{
+public:
+	// Type aliases
+	using self_type  = IKeybindRingBase;
+	using entry_type = Entry_;
+
+
+private:
+	Entry_* pBuf;        // First slot of the storage
+	size_t  nCapacity;   // Number of slots in the storage
+	size_t  nHead;       // Slot of the oldest entry
+	size_t  nSize;       // Number of stored entries
+	size_t  nOverflow;   // Number of entries dropped because the buffer was full
+
+
+protected:
+	/// @brief Constructs an empty buffer; the derived class provides the storage via `setStorage()`.
+	IKeybindRingBase() :
+		pBuf{ nullptr },
+		nCapacity{},
+		nHead{},
+		nSize{},
+		nOverflow{}
 	{}
 
-	/// @brief Assigns a key sequence and a primary key state to a specific event index.
-	/// This method defines what constitutes a keybind event.
-	///
-	/// @tparam N The number of key IDs in the `key_id_` array.
-	/// @param event_idx_ The index of the event to which this keybind is being assigned.
-	///                   Must be less than `Event_Count`.
-	/// @param key_id_ An `std::array` of key IDs that form the keybind sequence.
-	///                The last ID in this array is considered the "primary" key.
-	/// @param key_state_ The required `eState` of the primary key for this keybind event to trigger.
-	/// @throw std::out_of_range If `event_idx_` is out of bounds or `N` exceeds `Keybind_Max`.
-	/// @throw std::invalid_argument If any `key_id_` is not found in the available keys.
-	template <size_type N>
-	void assign(size_type event_idx_, std::array<size_type, N> key_id_, eState key_state_)
+	// Deleted constructors, the storage belongs to the derived object
+	IKeybindRingBase(const self_type&) = delete;
+	IKeybindRingBase(self_type&&) = delete;
+
+	void setStorage(Entry_* buf_, size_t capacity_)
 	{
-		if (event_idx_ >= Event_Count) {
-			throw std::out_of_range(
-				"IKeybind::assign: Event index is out of range.");
-		}
-		if (N > Keybind_Max) {
-			throw std::out_of_range(
-				"IKeybind::assign: Keybind size error.");
-		}
+		pBuf = buf_;
+		nCapacity = capacity_;
+	}
 
-		for (size_type i{}; i != N; ++i) {
-			size_type j{};
-			for (; j < Key_Count; ++j) {
-				if (aKey[j].id() == key_id_[i]) {
-					aKeybind[event_idx_][N - i - 1] = j;  // Convert id to idx and store in reverse order
-					break;
-				}
-			}
-			// If a key ID provided in `key_id_` was not found among the available keys
-			if (j == Key_Count) {
-				throw std::invalid_argument(
-					"IKeybind::assign: Key ID not found in available keys.");
-			}
+
+public:
+	/// @brief Appends an entry, or drops it and counts an overflow if the buffer is full.
+	///
+	/// @param entry_ The entry to append.
+	/// @return True if the entry was stored, false if it was dropped.
+	bool push(const Entry_& entry_)
+	{
+		if (nSize == nCapacity) {
+			++nOverflow;
+			return false;
 		}
-		aPrimaryKeyState[event_idx_] = key_state_;
-		aKeybindSize[event_idx_] = N;
+		size_t slot{ nHead + nSize };
+		if (slot >= nCapacity) { slot -= nCapacity; }
+		pBuf[slot] = entry_;
+		++nSize;
+		return true;
 	}
 
-	/// @brief Gets a reference to a key object by its index.
+	/// @brief Removes the oldest entry.
 	///
-	/// @param key_idx_ The index of the key to retrieve.
-	/// @return A reference to the `Key` object at the specified index.
-	/// @throw std::out_of_range If `key_idx_` is out of bounds.
-	Key& getKey(size_type key_idx_)
+	/// @param entry_ Receives the removed entry.
+	/// @return True if an entry was removed, false if the buffer was empty.
+	bool pop(Entry_& entry_)
 	{
-		if (key_idx_ >= Key_Count) {
-			throw std::out_of_range(
-				"IPushButton::getKey: Key index is out of range.");
-		}
-		return aKey[key_idx_];
+		if (!nSize) { return false; }
+		entry_ = pBuf[nHead];
+		if (++nHead == nCapacity) { nHead = 0; }
+		--nSize;
+		return true;
 	}
 
-	/// @brief Applies a unary function to each individual key managed by this keybind system.
+	/// @brief Removes all entries, oldest first, passing each one to a unary function.
 	///
 	/// @tparam UnaryFn_ The type of the unary function (e.g., a lambda, function pointer, functor).
-	/// @param fn_ The function to apply. It should take a `Key&` as an argument.
+	/// @param fn_ The function to apply. It should take a `const Entry_&` as an argument.
+	/// @return The number of removed entries.
 	template <typename UnaryFn_>
-	void forEachKey(UnaryFn_ fn_)
+	size_t drain(UnaryFn_ fn_)
 	{
-		for (auto& it : aKey) { fn_(it); }
+		size_t n{};
+		for (; nSize; ++n) {
+			fn_(static_cast<const Entry_&>(pBuf[nHead]));
+			if (++nHead == nCapacity) { nHead = 0; }
+			--nSize;
+		}
+		return n;
 	}
 
-	/// @brief Overrides IKeybindBase::update().
-	/// This method is called repeatedly to update the state of all managed keys
-	/// and then to detect if any defined keybind events have occurred.
-	void update() override
+	/// @brief Removes all entries without reading them. The overflow counter is kept.
+	void clear()
 	{
-		// Reset all event occurrence flags for the current cycle
-		aEventOccurred.fill(false);
-		// Update each individual key and reset its 'used as modifier' flag if it's idle or disabled
-		for (size_type i{}; i != Key_Count; ++i) {
-			aKey[i].update();
-			if (aKey[i].state() == eState::none
-				or aKey[i].state() & eState::idle) { 
-				aUsedAsModifier[i] = false;
-			}
-		}
-		// Perform the core keybind detection logic
-		searchKeybind();
+		nHead = 0;
+		nSize = 0;
 	}
 
-	/// @brief Overrides IKeybindBase::isEvent().
-	/// Checks if a specific keybind event has occurred in the most recent `update()` call.
+	/// @brief Returns the number of stored entries.
+	size_t size() const { return nSize; }
+
+	/// @brief Returns the number of slots.
+	size_t capacity() const { return nCapacity; }
+
+	/// @brief Returns true if no entry is stored.
+	bool empty() const { return !nSize; }
+
+	/// @brief Returns the number of entries dropped because the buffer was full.
+	size_t overflowCount() const { return nOverflow; }
+
+	/// @brief Resets the overflow counter.
+	void clearOverflow() { nOverflow = 0; }
+};
+
+
+/// @brief `IKeybindRingBase` with in-object storage for `Capacity_` entries.
+///
+/// @tparam Entry_ The type of the stored entries.
+/// @tparam Capacity_ The number of entries the buffer can hold.
+template < typename Entry_, size_t Capacity_ >
+class IKeybindRing : public IKeybindRingBase<Entry_>
+{
+	static_assert(Capacity_ > 0, "IKeybindRing: Capacity must be positive.");
+
+private:
+	/// @brief The storage for the entries.
+	std::array<Entry_, Capacity_> aBuf;
+
+public:
+	IKeybindRing() :
+		IKeybindRingBase<Entry_>(),
+		aBuf{}
+	{
+		this->setStorage(aBuf.data(), Capacity_);
+	}
+};
+
+
+
+/// @brief Lock-free single-producer/single-consumer FIFO over caller-provided storage.
+/// One context (e.g. a pin-change interrupt) pushes and another pops; neither blocks nor
+/// disables interrupts. The producer only stores the tail and the consumer only stores the
+/// head, each with release ordering, so an entry is complete before it becomes visible.
+/// When the buffer is full, new entries are dropped and counted as overflow.
+/// The storage is supplied by `IKeybindSpsc`.
+///
+/// @tparam Entry_ The type of the stored entries.
+template < typename Entry_ >
+class IKeybindSpscBase
+{
+public:
+	// Type aliases
+	using self_type  = IKeybindSpscBase;
+	using entry_type = Entry_;
+
+
+private:
+	Entry_*                  pBuf;       // First slot of the storage
+	uint8_t                  nSlots;     // Number of slots, one more than the capacity
+	IKeybindAtomic<uint8_t>  nHead;      // Slot of the oldest entry, stored by the consumer
+	IKeybindAtomic<uint8_t>  nTail;      // Slot of the next entry, stored by the producer
+	uint16_t                 nOverflow;  // Entries dropped because the buffer was full, written by the producer
+
+
+protected:
+	/// @brief Constructs an empty buffer; the derived class provides the storage via `setStorage()`.
+	IKeybindSpscBase() :
+		pBuf{ nullptr },
+		nSlots{},
+		nHead{ 0 },
+		nTail{ 0 },
+		nOverflow{}
+	{}
+
+	// Deleted constructors, the storage belongs to the derived object
+	IKeybindSpscBase(const self_type&) = delete;
+	IKeybindSpscBase(self_type&&) = delete;
+
+	void setStorage(Entry_* buf_, uint8_t slots_)
+	{
+		pBuf = buf_;
+		nSlots = slots_;
+	}
+
+
+public:
+	/// @brief Appends an entry. Producer side, safe to call from an interrupt.
 	///
-	/// @param event_idx_ The index of the event to check.
-	/// @return True if the specified event occurred, false otherwise. Returns false if `event_idx_` is out of bounds.
-	bool isEvent(size_type event_idx_) const override
+	/// @param entry_ The entry to append.
+	/// @return True if the entry was stored, false if it was dropped.
+	bool push(const Entry_& entry_)
 	{
-		if (event_idx_ >= Event_Count) { return false; }
-		return aEventOccurred[event_idx_];
+		const uint8_t tail{ nTail.load() };
+		const uint8_t next{ static_cast<uint8_t>(tail + 1 == nSlots ? 0 : tail + 1) };
+		if (next == nHead.load()) {
+			++nOverflow;
+			return false;
+		}
+		pBuf[tail] = entry_;
+		nTail.store(next);
+		return true;
 	}
 
-	/// @brief Overrides IKeybindBase::isAnyEvent().
-	/// Checks if any keybind event has occurred in the most recent `update()` call.
+	/// @brief Removes the oldest entry. Consumer side.
 	///
-	/// @return True if at least one event occurred, false otherwise.
-	bool isAnyEvent() const override
+	/// @param entry_ Receives the removed entry.
+	/// @return True if an entry was removed, false if the buffer was empty.
+	bool pop(Entry_& entry_)
 	{
-		for (auto& it : aEventOccurred) { if (it) { return true; } }
-		return false;
+		const uint8_t head{ nHead.load() };
+		if (head == nTail.load()) { return false; }
+		entry_ = pBuf[head];
+		nHead.store(static_cast<uint8_t>(head + 1 == nSlots ? 0 : head + 1));
+		return true;
 	}
 
-	/// @brief Clears all defined keybinds and resets internal state arrays.
-	/// This unassigns all events and prepares the `IKeybind` object for new keybind definitions.
-	void clear()
+	/// @brief Reads the oldest entry without removing it. Consumer side.
+	///
+	/// @param entry_ Receives the oldest entry.
+	/// @return True if an entry was read, false if the buffer was empty.
+	bool peek(Entry_& entry_) const
 	{
-		aKeybind         .fill({});
-		aKeybindSize     .fill({});
-		aPrimaryKeyState .fill({});
-		aEventOccurred   .fill({});
-		aUsedAsModifier  .fill({});
+		const uint8_t head{ nHead.load() };
+		if (head == nTail.load()) { return false; }
+		entry_ = pBuf[head];
+		return true;
 	}
 
+	/// @brief Returns true if no entry is stored. Valid on the consumer side.
+	bool empty() const { return nHead.load() == nTail.load(); }
+
+	/// @brief Returns the number of entries the buffer can hold.
+	size_t capacity() const { return nSlots - 1u; }
+
+	/// @brief Returns the number of entries dropped because the buffer was full.
+	/// Read it where the producer cannot interrupt, e.g. with interrupts disabled.
+	uint16_t overflowCount() const { return nOverflow; }
+};
+
+
+/// @brief `IKeybindSpscBase` with in-object storage for `Capacity_` entries.
+///
+/// @tparam Entry_ The type of the stored entries.
+/// @tparam Capacity_ The number of entries the buffer can hold, at most 254.
+template < typename Entry_, size_t Capacity_ >
+class IKeybindSpsc : public IKeybindSpscBase<Entry_>
+{
+	static_assert(Capacity_ > 0 and Capacity_ < 255, "IKeybindSpsc: Capacity must be in [1, 254].");
+
+private:
+	/// @brief The storage for the entries; one slot stays free to tell a full buffer from an empty one.
+	std::array<Entry_, Capacity_ + 1> aBuf;
+
+public:
+	IKeybindSpsc() :
+		IKeybindSpscBase<Entry_>(),
+		aBuf{}
+	{
+		this->setStorage(aBuf.data(), static_cast<uint8_t>(Capacity_ + 1));
+	}
+};
+
+
+
+//=== Keybind tries ===//
+/// @brief A trie of label strings whose nodes can carry an event, over caller-provided storage.
+/// The common part of `IKeybindSequenceBase` and `IKeybindPatternBase`. The edges are
+/// kept sorted by (node, label), so the edges leaving a node are contiguous; per-node CSR
+/// offsets locate them, and following an edge is one binary search among them only.
+///
+/// @tparam Index_ The type of the labels and event indices.
+template < typename Index_ >
+class IKeybindTrieBase
+{
+public:
+	// Type aliases
+	using self_type  = IKeybindTrieBase;
+	using index_type = Index_;
+	using node_type  = uint16_t;
+
+	/// @brief A trie edge: node `from` leads to node `to` on `label`.
+	struct Edge
+	{
+		node_type  from;   // Source node, 0 is the root
+		index_type label;  // Step event or key index
+		node_type  to;     // Target node
+	};
+
+
+private:
+	Edge*        pEdge;       // Edges sorted by (from, label)
+	node_type*   pEdgeBegin;  // Node -> Position of its first edge; its edges end at the next node's
+	index_type*  pOutput;     // Node -> Event index of the string ending there +1, or 0
+	node_type    nNodeMax;    // Number of nodes the storage holds, root included
+	node_type    nEdgeCount;  // Number of edges; node `n` is the target of the n-th added edge
+
+
+protected:
+	/// @brief Constructs an empty trie; the derived class provides the storage via `setStorage()`.
+	IKeybindTrieBase() :
+		pEdge{ nullptr },
+		pEdgeBegin{ nullptr },
+		pOutput{ nullptr },
+		nNodeMax{},
+		nEdgeCount{}
+	{}
+
+	// Deleted constructors, the storage belongs to the derived object
+	IKeybindTrieBase(const self_type&) = delete;
+	IKeybindTrieBase(self_type&&) = delete;
+
+	/// @param edge_ Storage for `node_max_ - 1` edges.
+	/// @param edge_begin_ Storage for `node_max_ + 1` edge offsets.
+	/// @param output_ Storage for `node_max_` events.
+	/// @param node_max_ The number of nodes, root included.
+	void setStorage(Edge* edge_, node_type* edge_begin_, index_type* output_, node_type node_max_)
+	{
+		pEdge = edge_;
+		pEdgeBegin = edge_begin_;
+		pOutput = output_;
+		nNodeMax = node_max_;
+		clear();
+	}
+
+	/// @brief Returns the position of the first edge leaving `node_`; they end at `edgeBegin(node_ +1)`.
+	node_type edgeBegin(node_type node_) const { return pEdgeBegin[node_]; }
+
+	/// @brief Returns the position of the first edge leaving `node_` whose label is not less than `label_`,
+	/// or `edgeBegin(node_ +1)` if there is none.
+	node_type lowerBound(node_type node_, index_type label_) const
+	{
+		node_type lo{ pEdgeBegin[node_] }, hi{ pEdgeBegin[node_ +1] };
+		while (lo != hi) {
+			const node_type mid{ static_cast<node_type>(lo + (hi - lo) / 2) };
+			if (pEdge[mid].label < label_) { lo = mid + 1; }
+			else { hi = mid; }
+		}
+		return lo;
+	}
+
+	/// @brief Follows the edge leaving `node_` on `label_`.
+	///
+	/// @return The target node, or 0 if there is no such edge.
+	node_type child(node_type node_, index_type label_) const
+	{
+		const node_type pos{ lowerBound(node_, label_) };
+		if (pos != pEdgeBegin[node_ +1] and pEdge[pos].label == label_) { return pEdge[pos].to; }
+		return 0;
+	}
+
+	/// @brief Returns true if no edge leaves `node_`.
+	bool isLeaf(node_type node_) const
+	{
+		return (pEdgeBegin[node_] == pEdgeBegin[node_ +1]);
+	}
+
+	/// @brief Returns the event index of the string ending at `node_` plus one, or 0.
+	index_type output(node_type node_) const { return pOutput[node_]; }
+
+	/// @brief Returns the edge at position `pos_` of the sorted edge table.
+	const Edge& edge(node_type pos_) const { return pEdge[pos_]; }
+
+
+public:
+	/// @brief Adds a string, sharing its prefix with the strings already added.
+	/// Adding the same string again replaces its event. The trie is left unchanged
+	/// if it has not enough free nodes for the new labels.
+	///
+	/// @param event_idx_ The event of the string.
+	/// @param label_ The labels of the string, first label first.
+	/// @param n_ The number of labels.
+	/// @throw std::out_of_range If the storage has not enough free nodes.
+	void insert(index_type event_idx_, const index_type* label_, size_t n_)
+	{
+		// Count the nodes that must be created
+		node_type node{};
+		size_t i{};
+		for (; i != n_; ++i) {
+			const node_type next{ child(node, label_[i]) };
+			if (!next) { break; }
+			node = next;
+		}
+		if (n_ - i > static_cast<size_t>(nNodeMax - 1 - nEdgeCount)) {
+			throw std::out_of_range(
+				"IKeybindTrie::insert: Node capacity exceeded.");
+		}
+
+		// Create the missing labels, keeping the edges sorted. The new node is the last one,
+		// so the edges of every node after `node` move up by one and the new node has none.
+		for (; i != n_; ++i) {
+			const node_type pos{ lowerBound(node, label_[i]) };
+			for (node_type e{ nEdgeCount }; e != pos; --e) { pEdge[e] = pEdge[e - 1]; }
+			for (node_type m{ static_cast<node_type>(node +1) }; m != nEdgeCount + 2; ++m) { ++pEdgeBegin[m]; }
+			++nEdgeCount;
+			pEdge[pos] = Edge{ node, label_[i], nEdgeCount };
+			pEdgeBegin[nEdgeCount +1] = nEdgeCount;  // The end of the new node's (empty) edges
+			pOutput[nEdgeCount] = 0;
+			node = nEdgeCount;
+		}
+		pOutput[node] = static_cast<index_type>(event_idx_ + 1);
+	}
+
+	/// @brief Removes all strings.
+	void clear()
+	{
+		nEdgeCount = 0;
+		pEdgeBegin[0] = 0;
+		pEdgeBegin[1] = 0;
+		pOutput[0] = 0;
+	}
+
+	/// @brief Returns the number of nodes in use, root included.
+	size_t size() const { return static_cast<size_t>(nEdgeCount) + 1; }
+
+	/// @brief Returns the number of nodes the storage holds, root included.
+	size_t capacity() const { return nNodeMax; }
+};
+
+
+
+/// @brief Recognizes events detected one after another, e.g. a leader key or `C-x C-s`.
+/// Every sequence is a path in the trie whose labels are step events; reaching the end
+/// of a path reports the event of that sequence. Advancing on a step follows one edge,
+/// however many sequences are defined. The storage is supplied by `IKeybindSequence`.
+///
+/// @tparam Index_ The type of event indices.
+/// @tparam Time_ The type of key push times.
+template < typename Index_, typename Time_ >
+class IKeybindSequenceBase : public IKeybindTrieBase<Index_>
+{
+public:
+	// Type aliases
+	using base_type  = IKeybindTrieBase<Index_>;
+	using index_type = Index_;
+	using time_type  = Time_;
+	using node_type  = typename base_type::node_type;
+
+
+private:
+	node_type  nNode;      // Current node
+	time_type  tLastStep;  // Push time of the last accepted step
+	time_type  tTimeout;   // Longest time allowed between two steps, 0 for none
+
+
+protected:
+	IKeybindSequenceBase() :
+		base_type(),
+		nNode{},
+		tLastStep{},
+		tTimeout{}
+	{}
+
+
+public:
+	/// @brief Advances on a detected event.
+	/// A step that comes later than the timeout after the previous one, or that continues no
+	/// sequence, restarts at the root, where it may begin a new sequence. The trie returns to
+	/// the root after a completed sequence unless a longer sequence continues it.
+	///
+	/// @param step_ The index of the detected event.
+	/// @param push_time_ The `pushTime()` of the primary key of that event.
+	/// @return The index of the completed sequence's event plus one, or 0.
+	index_type advance(index_type step_, time_type push_time_)
+	{
+		if (nNode and tTimeout and static_cast<time_type>(push_time_ - tLastStep) > tTimeout) { nNode = 0; }
+		node_type next{ this->child(nNode, step_) };
+		if (!next and nNode) { next = this->child(0, step_); }
+		nNode = next;
+		if (!nNode) { return 0; }
+
+		tLastStep = push_time_;
+		const index_type output{ this->output(nNode) };
+		if (output and this->isLeaf(nNode)) { nNode = 0; }
+		return output;
+	}
+
+	/// @brief Abandons a partially entered sequence.
+	void reset()
+	{
+		nNode = 0;
+	}
+
+	/// @brief Removes all sequences.
+	void clear()
+	{
+		base_type::clear();
+		nNode = 0;
+	}
+
+	/// @brief Sets the longest time allowed between two steps, in `pushTime()` units; 0 disables the timeout.
+	void timeout(time_type timeout_) { tTimeout = timeout_; }
+
+	/// @brief Returns true while a sequence is partially entered.
+	bool pending() const { return nNode != 0; }
+};
+
+
+/// @brief `IKeybindSequenceBase` with in-object storage for a trie of `NodeMax_` nodes.
+/// A sequence of `n` steps needs at most `n` nodes; steps shared with another sequence need none.
+///
+/// @tparam Index_ The type of event indices.
+/// @tparam Time_ The type of key push times.
+/// @tparam NodeMax_ The number of trie nodes, root included.
+template < typename Index_, typename Time_, size_t NodeMax_ >
+class IKeybindSequence : public IKeybindSequenceBase<Index_, Time_>
+{
+	static_assert(NodeMax_ >= 2 and NodeMax_ <= 0xFFFF, "IKeybindSequence: NodeMax must be in [2, 65535].");
+
+	using base_type = IKeybindSequenceBase<Index_, Time_>;
+
+private:
+	/// @brief The storage for the edges, their per-node offsets and the per-node events.
+	std::array<typename base_type::Edge, NodeMax_ - 1> aEdge;
+	std::array<typename base_type::node_type, NodeMax_ + 1> aEdgeBegin;
+	std::array<Index_, NodeMax_> aOutput;
+
+public:
+	IKeybindSequence() :
+		base_type(),
+		aEdge{},
+		aEdgeBegin{},
+		aOutput{}
+	{
+		this->setStorage(aEdge.data(), aEdgeBegin.data(), aOutput.data(), static_cast<typename base_type::node_type>(NodeMax_));
+	}
+};
+
+
+
+/// @brief Detects key patterns (service codes, unlock sequences) anywhere in the stream of key presses.
+/// An Aho-Corasick automaton: the trie of the patterns, whose labels are key indices, plus a
+/// failure link per node to the longest proper suffix that is also a trie path, and a match
+/// link to the nearest such suffix that ends a pattern. The links are built once, on the
+/// first press after a change; each press then costs O(1) amortized transitions, each a binary
+/// search among the edges of one node, however many patterns are defined. The storage is supplied by `IKeybindPattern`.
+///
+/// @tparam Index_ The type of key and event indices.
+/// @tparam Time_ The type of key push times.
+template < typename Index_, typename Time_ >
+class IKeybindPatternBase : public IKeybindTrieBase<Index_>
+{
+public:
+	// Type aliases
+	using base_type  = IKeybindTrieBase<Index_>;
+	using index_type = Index_;
+	using time_type  = Time_;
+	using node_type  = typename base_type::node_type;
+
+
+private:
+	node_type*  pFail;       // Node -> Longest proper suffix that is a trie path
+	node_type*  pMatch;      // Node -> Nearest suffix on the failure chain that ends a pattern, or 0
+	node_type*  pQueue;      // Scratch for the breadth-first walk of `build()`
+	node_type   nNode;       // Current node
+	time_type   tLastPress;  // Push time of the last press
+	time_type   tTimeout;    // Longest time allowed between two presses, 0 for none
+	bool        bBuilt;      // True if the links match the trie
+
+
+protected:
+	IKeybindPatternBase() :
+		base_type(),
+		pFail{ nullptr },
+		pMatch{ nullptr },
+		pQueue{ nullptr },
+		nNode{},
+		tLastPress{},
+		tTimeout{},
+		bBuilt{ false }
+	{}
+
+	void setStorage(typename base_type::Edge* edge_, node_type* edge_begin_, index_type* output_, node_type* fail_, node_type* match_, node_type* queue_, node_type node_max_)
+	{
+		base_type::setStorage(edge_, edge_begin_, output_, node_max_);
+		pFail = fail_;
+		pMatch = match_;
+		pQueue = queue_;
+	}
+
+
+private:
+	/// @brief Builds the failure and match links breadth-first, so the links of shorter
+	/// paths are final before they are used.
+	void build()
+	{
+		node_type head{}, tail{};
+		pFail[0] = 0;
+		pMatch[0] = 0;
+		pQueue[tail++] = 0;
+		while (head != tail) {
+			const node_type u{ pQueue[head++] };
+			const node_type end{ this->edgeBegin(u +1) };
+			for (node_type pos{ this->edgeBegin(u) }; pos != end; ++pos) {
+				const node_type v{ this->edge(pos).to };
+				const index_type label{ this->edge(pos).label };
+				node_type f{};
+				if (u) {
+					// Longest suffix of u that can be extended by `label`, one lookup per suffix
+					node_type suffix{ pFail[u] };
+					f = this->child(suffix, label);
+					while (!f and suffix) {
+						suffix = pFail[suffix];
+						f = this->child(suffix, label);
+					}
+				}
+				pFail[v] = f;
+				pMatch[v] = this->output(f) ? f : pMatch[f];
+				pQueue[tail++] = v;
+			}
+		}
+		nNode = 0;
+		bBuilt = true;
+	}
+
+
+public:
+	/// @brief Adds a pattern; see `IKeybindTrieBase::insert()`. The links are rebuilt by the next press.
+	void insert(index_type event_idx_, const index_type* key_idx_, size_t n_)
+	{
+		base_type::insert(event_idx_, key_idx_, n_);
+		bBuilt = false;
+	}
+
+	/// @brief Advances on a key press and reports every pattern that ends with it.
+	/// A press that comes later than the timeout after the previous one starts a new history.
+	///
+	/// @tparam UnaryFn_ The type of the unary function (e.g., a lambda, function pointer, functor).
+	/// @param key_idx_ The index of the pressed key.
+	/// @param push_time_ The `pushTime()` of the pressed key.
+	/// @param fn_ Called with the event index of each matched pattern, longest pattern first.
+	/// @return The number of matched patterns.
+	template <typename UnaryFn_>
+	size_t advance(index_type key_idx_, time_type push_time_, UnaryFn_ fn_)
+	{
+		if (!bBuilt) { build(); }
+		if (tTimeout and static_cast<time_type>(push_time_ - tLastPress) > tTimeout) { nNode = 0; }
+		tLastPress = push_time_;
+
+		node_type next{ this->child(nNode, key_idx_) };
+		while (!next and nNode) {
+			nNode = pFail[nNode];
+			next = this->child(nNode, key_idx_);
+		}
+		nNode = next;
+
+		size_t n{};
+		for (node_type m{ this->output(nNode) ? nNode : pMatch[nNode] }; m; m = pMatch[m], ++n) {
+			fn_(static_cast<index_type>(this->output(m) - 1));
+		}
+		return n;
+	}
+
+	/// @brief Forgets the press history.
+	void reset()
+	{
+		nNode = 0;
+	}
+
+	/// @brief Removes all patterns.
+	void clear()
+	{
+		base_type::clear();
+		nNode = 0;
+		bBuilt = false;
+	}
+
+	/// @brief Sets the longest time allowed between two presses, in `pushTime()` units; 0 disables the timeout.
+	void timeout(time_type timeout_) { tTimeout = timeout_; }
+};
+
+
+/// @brief `IKeybindPatternBase` with in-object storage for an automaton of `NodeMax_` nodes.
+/// A pattern of `n` presses needs at most `n` nodes; prefixes shared with another pattern need none.
+///
+/// @tparam Index_ The type of key and event indices.
+/// @tparam Time_ The type of key push times.
+/// @tparam NodeMax_ The number of trie nodes, root included.
+template < typename Index_, typename Time_, size_t NodeMax_ >
+class IKeybindPattern : public IKeybindPatternBase<Index_, Time_>
+{
+	static_assert(NodeMax_ >= 2 and NodeMax_ <= 0xFFFF, "IKeybindPattern: NodeMax must be in [2, 65535].");
+
+	using base_type = IKeybindPatternBase<Index_, Time_>;
+	using node_type = typename base_type::node_type;
+
+private:
+	/// @brief The storage for the edges and their per-node offsets, the per-node events and links, and the build scratch.
+	std::array<typename base_type::Edge, NodeMax_ - 1> aEdge;
+	std::array<node_type, NodeMax_ + 1> aEdgeBegin;
+	std::array<Index_, NodeMax_> aOutput;
+	std::array<node_type, NodeMax_> aFail;
+	std::array<node_type, NodeMax_> aMatch;
+	std::array<node_type, NodeMax_> aQueue;
+
+public:
+	IKeybindPattern() :
+		base_type(),
+		aEdge{},
+		aEdgeBegin{},
+		aOutput{},
+		aFail{},
+		aMatch{},
+		aQueue{}
+	{
+		this->setStorage(aEdge.data(), aEdgeBegin.data(), aOutput.data(), aFail.data(), aMatch.data(), aQueue.data(), static_cast<node_type>(NodeMax_));
+	}
+};
+
+
+
+//=== Timer wheel ===//
+/// @brief A hashed timer wheel of one timer per index, over caller-provided storage.
+/// Every slot covers one tick of `2^tick_shift` time units and holds a doubly linked list of the
+/// timers expiring in that tick, in any later revolution. `expire()` only visits the slots of
+/// the ticks that passed since its previous call, so its cost follows the number of timers
+/// expiring (plus the ones sharing their slots), not the number of timers.
+/// Links are stored as index +1, 0 ends a list. Ticks wrap together with the time (at
+/// `2^(bits - tick_shift)`), so they are compared in the wrapped tick space, and every timer
+/// remembers the slot it is linked into.
+///
+/// @tparam Index_ The type of the timer indices.
+/// @tparam Time_ The type of the expiry times; unsigned, compared wrap-around safe.
+template < typename Index_, typename Time_ >
+class IKeybindTimerWheelBase
+{
+public:
+	// Type aliases
+	using index_type = Index_;
+	using time_type  = Time_;
+
+public:
+	// Compile-time constants
+	static const time_type No_Timer{ static_cast<time_type>(~time_type(0)) };  // Returned by `next()` if no timer is armed
+
+
+private:
+	index_type*  pHead;       // Slot -> First timer +1, or 0
+	index_type*  pNext;       // Timer -> Next timer in its slot +1, or 0
+	index_type*  pPrev;       // Timer -> Previous timer in its slot +1, or 0 if it is the first
+	time_type*   pExpiry;     // Timer -> Expiry time
+	uint16_t*    pSlot;       // Timer -> Slot it is linked into +1, or 0 if it is not armed
+	size_t       nSlotMask;   // Number of slots -1, a power of two minus one
+	uint8_t      nTickShift;  // log2 of the time units per tick
+	time_type    nLastTick;   // Tick of the previous `expire()`
+
+
+	static bool isBefore(time_type a_, time_type b_)
+	{
+		return static_cast<typename std::make_signed<time_type>::type>(a_ - b_) < 0;
+	}
+
+	/// @brief Wrap-around safe `a_ < b_` for ticks, which only have `bits - nTickShift` bits.
+	bool isTickBefore(time_type a_, time_type b_) const
+	{
+		return isBefore(static_cast<time_type>(a_ << nTickShift), static_cast<time_type>(b_ << nTickShift));
+	}
+
+	size_t slotOf(time_type expiry_) const
+	{
+		time_type tick{ static_cast<time_type>(expiry_ >> nTickShift) };
+		if (isTickBefore(tick, nLastTick)) { tick = nLastTick; }  // Overdue: due with the next expire()
+		return tick & nSlotMask;
+	}
+
+	void unlink(index_type timer_)
+	{
+		const index_type next{ pNext[timer_] };
+		const index_type prev{ pPrev[timer_] };
+		if (prev) { pNext[prev -1] = next; }
+		else { pHead[pSlot[timer_] -1] = next; }
+		if (next) { pPrev[next -1] = prev; }
+		pSlot[timer_] = 0;
+	}
+
+
+protected:
+	IKeybindTimerWheelBase() :
+		pHead{ nullptr },
+		pNext{ nullptr },
+		pPrev{ nullptr },
+		pExpiry{ nullptr },
+		pSlot{ nullptr },
+		nSlotMask{},
+		nTickShift{},
+		nLastTick{}
+	{}
+
+	/// @brief Sets the storage; called once by the derived class.
+	void setStorage(index_type* head_, index_type* next_, index_type* prev_, time_type* expiry_, uint16_t* slot_, size_t slots_, uint8_t tick_shift_)
+	{
+		pHead = head_;
+		pNext = next_;
+		pPrev = prev_;
+		pExpiry = expiry_;
+		pSlot = slot_;
+		nSlotMask = slots_ - 1;
+		nTickShift = tick_shift_;
+	}
+
+
+public:
+	/// @brief Arms a timer, replacing its previous expiry. A time not in the future expires
+	/// with the next `expire()`.
+	///
+	/// @param timer_ The index of the timer.
+	/// @param expiry_ The expiry time.
+	void schedule(index_type timer_, time_type expiry_)
+	{
+		if (pSlot[timer_]) { unlink(timer_); }
+		pExpiry[timer_] = expiry_;
+		const size_t slot{ slotOf(expiry_) };
+		pPrev[timer_] = 0;
+		pNext[timer_] = pHead[slot];
+		if (pHead[slot]) { pPrev[pHead[slot] -1] = static_cast<index_type>(timer_ +1); }
+		pHead[slot] = static_cast<index_type>(timer_ +1);
+		pSlot[timer_] = static_cast<uint16_t>(slot +1);
+	}
+
+	/// @brief Disarms a timer, if it is armed.
+	void cancel(index_type timer_)
+	{
+		if (pSlot[timer_]) { unlink(timer_); }
+	}
+
+	/// @brief Returns true if a timer is armed.
+	bool armed(index_type timer_) const { return pSlot[timer_] != 0; }
+
+	/// @brief Disarms every timer of the slots of the ticks up to `now_` that expired, and calls
+	/// `fn_(timer)` for each. Visits the slots of the ticks since the previous call, the current
+	/// tick included; at most one revolution. `fn_` must not schedule or cancel timers.
+	///
+	/// @param now_ The current time.
+	/// @param fn_ Called with the index of every expired timer.
+	/// @return The number of expired timers.
+	template <typename UnaryFn_>
+	size_t expire(time_type now_, UnaryFn_ fn_)
+	{
+		const time_type now_tick{ static_cast<time_type>(now_ >> nTickShift) };
+		const time_type elapsed{ static_cast<time_type>((now_tick - nLastTick) & (~time_type(0) >> nTickShift)) };
+		const size_t ticks{ (isTickBefore(now_tick, nLastTick) or elapsed > nSlotMask) ? nSlotMask + 1 : elapsed + 1u };
+		size_t count{};
+		for (size_t t{}; t != ticks; ++t) {
+			const size_t slot{ (nLastTick + t) & nSlotMask };
+			for (index_type it{ pHead[slot] }; it != 0; ) {
+				const index_type timer{ static_cast<index_type>(it -1) };
+				it = pNext[timer];
+				if (isBefore(now_, pExpiry[timer])) { continue; }  // A later revolution
+				unlink(timer);
+				fn_(timer);
+				++count;
+			}
+		}
+		nLastTick = now_tick;
+		return count;
+	}
+
+	/// @brief Returns the earliest expiry of the armed timers, or `No_Timer` if none is armed.
+	/// Visits the slots in tick order from the previous `expire()` and stops at the first one
+	/// that holds a timer of the current revolution.
+	time_type next() const
+	{
+		time_type best{ No_Timer };
+		bool found{ false };
+		for (size_t t{}; t <= nSlotMask; ++t) {
+			for (index_type it{ pHead[(nLastTick + t) & nSlotMask] }; it != 0; it = pNext[it -1]) {
+				const time_type expiry{ pExpiry[it -1] };
+				if (!found or isBefore(expiry, best)) { best = expiry; }
+				found = true;
+			}
+			if (found and !isTickBefore(static_cast<time_type>(nLastTick + t), static_cast<time_type>(best >> nTickShift))) { break; }
+		}
+		return best;
+	}
+};
+
+
+/// @brief A hashed timer wheel with its own storage.
+///
+/// @tparam Index_ The type of the timer indices.
+/// @tparam Time_ The type of the expiry times.
+/// @tparam NTimer_ The number of timers.
+/// @tparam NSlot_ The number of slots, a power of two; the wheel turns once every `NSlot_` ticks.
+/// @tparam TickShift_ log2 of the time units per tick, e.g. 2 for 4 ms ticks with `millis()`.
+template < typename Index_, typename Time_, size_t NTimer_, size_t NSlot_, uint8_t TickShift_ = 0 >
+class IKeybindTimerWheel : public IKeybindTimerWheelBase<Index_, Time_>
+{
+	static_assert(NSlot_ >= 2 and (NSlot_ & (NSlot_ - 1)) == 0, "IKeybindTimerWheel: NSlot must be a power of two.");
+	static_assert(NSlot_ <= 0x8000, "IKeybindTimerWheel: NSlot must be at most 32768.");
+	static_assert(TickShift_ < sizeof(Time_) * 8, "IKeybindTimerWheel: TickShift must be less than the bits of the time type.");
+	static_assert((NSlot_ - 1) <= (~Time_(0) >> TickShift_), "IKeybindTimerWheel: A revolution must not exceed the tick range.");
+
+private:
+	/// @brief The storage for the slot heads and the timers.
+	std::array<Index_, NSlot_> aHead;
+	std::array<Index_, NTimer_> aNext;
+	std::array<Index_, NTimer_> aPrev;
+	std::array<Time_, NTimer_> aExpiry;
+	std::array<uint16_t, NTimer_> aSlot;
+
+public:
+	IKeybindTimerWheel() :
+		IKeybindTimerWheelBase<Index_, Time_>(),
+		aHead{},
+		aNext{},
+		aPrev{},
+		aExpiry{},
+		aSlot{}
+	{
+		this->setStorage(aHead.data(), aNext.data(), aPrev.data(), aExpiry.data(), aSlot.data(), NSlot_, TickShift_);
+	}
+};
+
+
+
+//=== Base interface for keybinding logic ===//
+// Runtime-polymorphic interface, implemented by `IKeybindHandle`.
+class IKeybindBase
+{
+public:
+	// Type aliases
+	using self_type  = IKeybindBase;
+	using size_type  = size_t;
+	using Key        = IPushButton;
+	using eState     = IPushButton::eState;
+
+public:
+	// Virtual destructor
+	virtual ~IKeybindBase() = default;
+	// Updates the state of all keys and checks for triggered keybind events
+	virtual void update() = 0;
+	// Checks if a specific keybind event has occurred
+	virtual bool isEvent(size_type) const = 0;
+	// Checks if any keybind event has occurred
+	virtual bool isAnyEvent() const = 0;
+};
+
+
+
+//=== Keybind definitions ===//
+/// @brief The keybind definitions of a keybind system and the indexes derived from them.
+/// A keymap is edited at runtime by `IKeybind::assign()`, or built at compile time by
+/// `makeKeymap()` into a read-only table that lives in flash/rodata and is evaluated
+/// in place by `IKeybindStatic`.
+///
+/// Indexes use the smallest unsigned type that holds `NKey_` and `NEvent_` (see `size_type`),
+/// so up to 255 keys and events cost one byte per index.
+///
+/// The key sequences are stored in one of two modes. By default every event reserves
+/// `KbMax_` key slots. With a pool size `NPool_`, all sequences are packed back to back into
+/// one pool of `NPool_` keys with per-event offsets (CSR layout), so the RAM follows the real
+/// binding lengths; `set()` then moves the sequences behind the edited one.
+///
+/// @tparam NKey_ The maximum number of individual keys.
+/// @tparam NEvent_ The maximum number of distinct keybind events.
+/// @tparam KbMax_ The maximum number of keys that can be part of a single keybind sequence.
+/// @tparam NPool_ The total number of keys of all sequences, or 0 to reserve `KbMax_` keys per event.
+template < size_t NKey_, size_t NEvent_, size_t KbMax_ = NKey_, size_t NPool_ = 0 >
+class IKeymap
+{
+	template <typename> friend class IKeymapProgmem;
+
+	static_assert(NKey_ > 0 and NKey_ <= 0xFFFF, "IKeymap: NKey must be in [1, 65535].");
+	static_assert(NEvent_ > 0 and NEvent_ <= 0xFFFF, "IKeymap: NEvent must be in [1, 65535].");
+	static_assert(KbMax_ > 0 and KbMax_ <= NKey_, "IKeymap: KbMax must be in [1, NKey].");
+	static_assert(NPool_ <= 0xFFFF, "IKeymap: NPool must be at most 65535.");
+
+public:
+	// Type aliases
+	using self_type  = IKeymap;
+	using size_type  = IKeybindUint<(NKey_ > NEvent_ ? NKey_ : NEvent_)>;  // Holds every key and event index, and Event_Count (event index +1)
+	using eState     = IPushButton::eState;
+	using ref_type   = IKeybindUint<(NPool_ ? NPool_ : static_cast<uint32_t>(NEvent_) * KbMax_)>;  // Holds a reverse index position (one per key of every keybind)
+	using pool_type  = IKeybindUint<NPool_>;  // Holds a position in the key pool
+	using key_mask   = IKeybindBitset<NKey_>;
+	using event_mask = IKeybindBitset<NEvent_>;
+
+public:
+	// Compile-time constants
+	static const size_type Key_Count{ NKey_ };
+	static const size_type Event_Count{ NEvent_ };
+	static const size_type Keybind_Max{ KbMax_ };
+	static const pool_type Pool_Size{ NPool_ };  // 0 if every event reserves `Keybind_Max` keys
+
+
+private:
+	/// @brief A 2D array storing the key indices for each defined keybind event (without pool).
+	/// `aKeybind[event_idx][key_in_sequence_idx]` stores the index of the key in the key array,
+	/// in reverse order: index 0 is the primary key.
+	std::array<std::array<size_type, Keybind_Max>, (NPool_ ? 0 : Event_Count)> aKeybind;
+
+	/// @brief An array storing the actual number of keys in each defined keybind (without pool).
+	/// `aKeybindSize[event_idx]` holds the size of the keybind at `event_idx`.
+	std::array<size_type, (NPool_ ? 0 : Event_Count)> aKeybindSize;
+
+	/// @brief The key indices of all keybinds, packed back to back (with pool).
+	/// The keybind at `event_idx` is `aKeyPool[aPoolBegin[event_idx] .. aPoolBegin[event_idx +1])`,
+	/// in reverse order like `aKeybind`.
+	std::array<size_type, NPool_> aKeyPool;
+
+	/// @brief CSR offsets of the keybinds in `aKeyPool`; the last one is the number of keys in use.
+	std::array<pool_type, (NPool_ ? Event_Count + 1 : 0)> aPoolBegin;
+
+	/// @brief An array storing the required state for the primary key of each event.
+	/// `aPrimaryKeyState[event_idx]` specifies the `eState` that the final key
+	/// in the keybind sequence (the primary key) must be in for the event to trigger.
+	std::array<eState, Event_Count> aPrimaryKeyState;
+
+	/// @brief The modifier keys of each keybind as a key bitset.
+	/// `aModifierMask[event_idx]` has a bit set for every key of the sequence except the primary key.
+	std::array<key_mask, Event_Count> aModifierMask;
+
+	/// @brief Keybinds whose keys may be pressed in any order, see `unordered()`.
+	event_mask aUnordered;
+
+	/// @brief Keybinds a longer keybind can still extend when they are detected, see `ambiguous()`.
+	/// Derived from the keybinds by `rebuild()`.
+	event_mask aAmbiguous;
+
+	/// @brief Keys that complete an unordered chord stored in the bucket of another key, see `chordKey()`.
+	/// Derived from the keybinds by `rebuild()`.
+	key_mask aChordKey;
+
+	/// @brief CSR offsets of the primary-key bucket index.
+	/// The events whose primary key is `key_idx` are stored in
+	/// `aBucketEvent[aBucketBegin[key_idx] .. aBucketBegin[key_idx +1])`.
+	std::array<size_type, Key_Count + 1> aBucketBegin;
+
+	/// @brief Assigned event indices grouped by primary key.
+	/// Inside a bucket, events are sorted by `aKeybindSize` descending and, for equal sizes,
+	/// by event index descending, so the first valid match found is the one to report.
+	std::array<size_type, Event_Count> aBucketEvent;
+
+	/// @brief CSR offsets of the reverse index (key -> events that reference it).
+	/// The events that use `key_idx` as primary or modifier key are stored in
+	/// `aRefEvent[aRefBegin[key_idx] .. aRefBegin[key_idx +1])`.
+	std::array<ref_type, Key_Count + 1> aRefBegin;
+
+	/// @brief Event indices grouped by referenced key.
+	std::array<size_type, (NPool_ ? NPool_ : Event_Count * Keybind_Max)> aRefEvent;
+
+	/// @brief The key IDs the key indices were resolved against by `makeKeymap()`, in key index order.
+	/// `IKeybindStatic` checks its keys against them; unused by keymaps edited at runtime.
+	std::array<uint16_t, Key_Count> aKeyId;
+
+
+public:
+	/// @brief Constructs an empty keymap.
+	IKEYBIND_CONSTEXPR IKeymap() :
+		aKeybind{},
+		aKeybindSize{},
+		aKeyPool{},
+		aPoolBegin{},
+		aPrimaryKeyState{},
+		aModifierMask{},
+		aUnordered{},
+		aAmbiguous{},
+		aChordKey{},
+		aBucketBegin{},
+		aBucketEvent{},
+		aRefBegin{},
+		aRefEvent{},
+		aKeyId{}
+	{}
+
+	/// @brief Returns the number of keys of the keybind at `event_idx_`, 0 if it is not assigned.
+	IKEYBIND_CONSTEXPR size_type size(size_type event_idx_) const
+	{
+		return NPool_ ? static_cast<size_type>(aPoolBegin[event_idx_ +1] - aPoolBegin[event_idx_]) : aKeybindSize[event_idx_];
+	}
+
+	/// @brief Returns the key index at position `pos_` of a keybind; position 0 is the primary key.
+	IKEYBIND_CONSTEXPR size_type keyIdx(size_type event_idx_, size_type pos_) const
+	{
+		return NPool_ ? aKeyPool[aPoolBegin[event_idx_] + pos_] : aKeybind[event_idx_][pos_];
+	}
+
+	/// @brief Returns true if `set()` can store a keybind of `n_` keys at `event_idx_`.
+	/// Always true for `n_` up to `Keybind_Max` without pool; with pool, the keys must fit
+	/// the pool once the current keybind of the event is removed.
+	IKEYBIND_CONSTEXPR bool fits(size_type event_idx_, size_t n_) const
+	{
+		return n_ <= Keybind_Max and (!NPool_ or aPoolBegin[Event_Count] - size(event_idx_) + n_ <= NPool_);
+	}
+
+	/// @brief Returns the required state of the primary key of a keybind.
+	IKEYBIND_CONSTEXPR eState primaryState(size_type event_idx_) const { return aPrimaryKeyState[event_idx_]; }
+
+	/// @brief Returns the modifier keys of a keybind.
+	IKEYBIND_CONSTEXPR const key_mask& modifiers(size_type event_idx_) const { return aModifierMask[event_idx_]; }
+
+	/// @brief Returns true if the keys of a keybind may be pressed in any order within the chord window.
+	IKEYBIND_CONSTEXPR bool unordered(size_type event_idx_) const { return aUnordered.test(event_idx_); }
+
+	/// @brief Returns true if a longer keybind can still complete when this one is detected:
+	/// its primary key is detected while down (pushed, held or delayed), and all its keys are
+	/// modifiers of a longer keybind. Every key of an unordered chord may be held as modifier
+	/// while another one completes it. Up to date after `rebuild()`.
+	IKEYBIND_CONSTEXPR bool ambiguous(size_type event_idx_) const { return aAmbiguous.test(event_idx_); }
+
+	/// @brief Returns true if the key is a modifier of an unordered chord, so it may complete
+	/// the chord from outside its primary key bucket. Up to date after `rebuild()`.
+	IKEYBIND_CONSTEXPR bool chordKey(size_type key_idx_) const { return aChordKey.test(key_idx_); }
+
+	/// @brief Returns the first bucket position of a primary key; the bucket ends at `bucketBegin(key_idx_ +1)`.
+	IKEYBIND_CONSTEXPR size_type bucketBegin(size_type key_idx_) const { return aBucketBegin[key_idx_]; }
+
+	/// @brief Returns the event at a bucket position.
+	IKEYBIND_CONSTEXPR size_type bucketEvent(size_type pos_) const { return aBucketEvent[pos_]; }
+
+	/// @brief Returns the first reverse index position of a key; it ends at `refBegin(key_idx_ +1)`.
+	IKEYBIND_CONSTEXPR ref_type refBegin(size_type key_idx_) const { return aRefBegin[key_idx_]; }
+
+	/// @brief Returns the event at a reverse index position.
+	IKEYBIND_CONSTEXPR size_type refEvent(ref_type pos_) const { return aRefEvent[pos_]; }
+
+	/// @brief Returns the ID of the key at `key_idx_` the keymap was built for, see `setKeyIds()`.
+	IKEYBIND_CONSTEXPR uint16_t keyId(size_type key_idx_) const { return aKeyId[key_idx_]; }
+
+	/// @brief Records the key IDs the keybinds were resolved against, in key index order.
+	IKEYBIND_CONSTEXPR void setKeyIds(const std::array<uint16_t, NKey_>& key_id_)
+	{
+		for (size_type k{}; k != Key_Count; ++k) { aKeyId[k] = key_id_[k]; }
+	}
+
+	/// @brief Defines the keybind of an event. Arguments are not checked (see `fits()`); the
+	/// indexes are outdated until `rebuild()` is called.
+	///
+	/// @param event_idx_ The index of the event, less than `Event_Count`.
+	/// @param key_idx_ The key indices of the sequence; the last one is the primary key.
+	/// @param n_ The number of keys in the sequence, at most `Keybind_Max`.
+	/// @param key_state_ The required `eState` of the primary key.
+	/// @param unordered_ True if the keys may be pressed in any order, false if the modifiers must be pressed first.
+	IKEYBIND_CONSTEXPR void set(size_type event_idx_, const std::array<size_type, Keybind_Max>& key_idx_, size_type n_, eState key_state_, bool unordered_ = false)
+	{
+		size_type* keys{};
+		if (NPool_) {
+			// Make room: move the keybinds of the following events
+			const pool_type begin{ aPoolBegin[event_idx_] };
+			const pool_type end{ aPoolBegin[event_idx_ +1] };
+			const pool_type used{ aPoolBegin[Event_Count] };
+			const pool_type dest{ static_cast<pool_type>(begin + n_) };
+			if (dest < end) {
+				for (pool_type p{}; p != used - end; ++p) { aKeyPool[dest + p] = aKeyPool[end + p]; }
+			}
+			else if (dest > end) {
+				for (pool_type p{ static_cast<pool_type>(used - end) }; p-- != 0; ) { aKeyPool[dest + p] = aKeyPool[end + p]; }
+			}
+			for (size_t e{ event_idx_ +1u }; e != Event_Count + 1u; ++e) {
+				aPoolBegin[e] = static_cast<pool_type>(aPoolBegin[e] - end + dest);
+			}
+			keys = aKeyPool.data() + begin;
+		}
+		else {
+			keys = aKeybind[event_idx_].data();
+			aKeybindSize[event_idx_] = n_;
+		}
+
+		key_mask modifiers{};
+		for (size_type i{}; i != n_; ++i) {
+			keys[n_ - i - 1] = key_idx_[i];  // Store in reverse order
+			if (i != n_ - 1) { modifiers.set(key_idx_[i]); }  // All but the last key are modifiers
+		}
+		aPrimaryKeyState[event_idx_] = key_state_;
+		aModifierMask[event_idx_] = modifiers;
+		if (unordered_) { aUnordered.set(event_idx_); }
+		else { aUnordered.reset(event_idx_); }
+	}
+
+	/// @brief Removes all keybinds, including the indexes.
+	/// Unassigned sequences are not read, so only the sizes and the index offsets are reset.
+	IKEYBIND_CONSTEXPR void clear()
+	{
+		for (auto& it : aKeybindSize)     { it = 0; }
+		for (auto& it : aPoolBegin)       { it = 0; }
+		for (auto& it : aPrimaryKeyState) { it = eState{}; }
+		for (auto& it : aModifierMask)    { it = key_mask{}; }
+		aUnordered = event_mask{};
+		aAmbiguous = event_mask{};
+		aChordKey = key_mask{};
+		for (auto& it : aBucketBegin)     { it = 0; }
+		for (auto& it : aRefBegin)        { it = 0; }
+	}
+
+	/// @brief Rebuilds the primary-key bucket index and the reverse index from the keybinds.
+	/// Events are counted per primary key, scattered into their buckets and then
+	/// ordered by sequence length (longest first) inside each bucket. Ambiguous keybinds are
+	/// then found through the reverse index of their primary key.
+	IKEYBIND_CONSTEXPR void rebuild()
+	{
+		for (auto& it : aBucketBegin) { it = 0; }
+		for (size_type i{}; i != Event_Count; ++i) {
+			if (!size(i)) { continue; }
+			++aBucketBegin[keyIdx(i, 0) +1];
+		}
+		for (size_type k{}; k != Key_Count; ++k) {
+			aBucketBegin[k +1] += aBucketBegin[k];
+		}
+
+		// Scatter in descending event order, so ties on size keep the later event first
+		std::array<size_type, Key_Count> aFill{};
+		for (size_type i{ Event_Count }; i-- != 0; ) {
+			if (!size(i)) { continue; }
+			const size_type k{ keyIdx(i, 0) };
+			aBucketEvent[aBucketBegin[k] + aFill[k]++] = i;
+		}
+
+		// Stable insertion sort by size inside each bucket (buckets are short)
+		for (size_type k{}; k != Key_Count; ++k) {
+			for (size_type p{ static_cast<size_type>(aBucketBegin[k] +1) }; p < aBucketBegin[k +1]; ++p) {
+				const size_type e{ aBucketEvent[p] };
+				size_type q{ p };
+				for (; q > aBucketBegin[k] and size(aBucketEvent[q -1]) < size(e); --q) {
+					aBucketEvent[q] = aBucketEvent[q -1];
+				}
+				aBucketEvent[q] = e;
+			}
+		}
+
+		// Reverse index: every key of a keybind refers back to its event
+		for (auto& it : aRefBegin) { it = 0; }
+		for (size_type i{}; i != Event_Count; ++i) {
+			for (size_type j{}; j < size(i); ++j) {
+				++aRefBegin[keyIdx(i, j) +1];
+			}
+		}
+		for (size_type k{}; k != Key_Count; ++k) {
+			aRefBegin[k +1] += aRefBegin[k];
+		}
+		std::array<ref_type, Key_Count> aRefFill{};
+		for (size_type i{}; i != Event_Count; ++i) {
+			for (size_type j{}; j < size(i); ++j) {
+				const size_type k{ keyIdx(i, j) };
+				aRefEvent[aRefBegin[k] + aRefFill[k]++] = i;
+			}
+		}
+
+		// Ambiguity: a longer keybind can hold all keys as modifiers, the primary key included.
+		// The candidates contain the primary key, so they are found through its reverse index.
+		aAmbiguous = event_mask{};
+		aChordKey = key_mask{};
+		for (size_type i{}; i != Event_Count; ++i) {
+			if (size(i) and aUnordered.test(i)) { aChordKey |= aModifierMask[i]; }
+			if (!size(i) or !(aPrimaryKeyState[i] & (eState::push | eState::hold | eState::delay))) { continue; }
+			const size_type k{ keyIdx(i, 0) };
+			key_mask keys{ aModifierMask[i] };
+			keys.set(k);
+			for (ref_type r{ aRefBegin[k] }; r != aRefBegin[k +1]; ++r) {
+				const size_type f{ aRefEvent[r] };
+				if (size(f) <= size(i)) { continue; }
+				key_mask held{ aModifierMask[f] };
+				if (aUnordered.test(f)) { held.set(keyIdx(f, 0)); }  // Any key may complete the chord
+				if (held.includes(keys)) {
+					aAmbiguous.set(i);
+					break;
+				}
+			}
+		}
+	}
+};
+
+
+/// @brief Reads a value from program memory on AVR, or from ordinary memory elsewhere.
+template < typename T_ >
+T_ IKeybindFlashRead(const T_& ref_)
+{
+#if defined(__AVR__)
+	T_ value;
+	memcpy_P(&value, &ref_, sizeof(T_));
+	return value;
+#else
+	return ref_;
+#endif
+}
+
+
+/// @brief Read accessor for an `IKeymap` placed in AVR program memory (`PROGMEM`).
+/// Provides the same accessors as `IKeymap`, reading every element with `memcpy_P`.
+///
+/// @tparam Keymap_ The `IKeymap` instantiation stored in program memory.
+template < typename Keymap_ >
+class IKeymapProgmem
+{
+public:
+	// Type aliases
+	using size_type  = typename Keymap_::size_type;
+	using eState     = typename Keymap_::eState;
+	using ref_type   = typename Keymap_::ref_type;
+	using key_mask   = typename Keymap_::key_mask;
+
+
+private:
+	const Keymap_& rKeymap;
+
+
+public:
+	explicit IKeymapProgmem(const Keymap_& keymap_) :
+		rKeymap{ keymap_ }
+	{}
+
+	size_type size(size_type event_idx_) const
+	{
+		if (Keymap_::Pool_Size) {
+			return static_cast<size_type>(IKeybindFlashRead(rKeymap.aPoolBegin[event_idx_ +1]) - IKeybindFlashRead(rKeymap.aPoolBegin[event_idx_]));
+		}
+		return IKeybindFlashRead(rKeymap.aKeybindSize[event_idx_]);
+	}
+	size_type keyIdx(size_type event_idx_, size_type pos_) const
+	{
+		if (Keymap_::Pool_Size) {
+			return IKeybindFlashRead(rKeymap.aKeyPool[IKeybindFlashRead(rKeymap.aPoolBegin[event_idx_]) + pos_]);
+		}
+		return IKeybindFlashRead(rKeymap.aKeybind[event_idx_][pos_]);
+	}
+	eState primaryState(size_type event_idx_) const { return IKeybindFlashRead(rKeymap.aPrimaryKeyState[event_idx_]); }
+	key_mask modifiers(size_type event_idx_) const { return IKeybindFlashRead(rKeymap.aModifierMask[event_idx_]); }
+	bool unordered(size_type event_idx_) const
+	{
+		using word_type = typename Keymap_::event_mask::word_type;
+		const size_t bits{ Keymap_::event_mask::Word_Bits };
+		return (IKeybindFlashRead<word_type>(rKeymap.aUnordered.words()[event_idx_ / bits]) >> (event_idx_ % bits)) & 1u;
+	}
+	bool ambiguous(size_type event_idx_) const
+	{
+		using word_type = typename Keymap_::event_mask::word_type;
+		const size_t bits{ Keymap_::event_mask::Word_Bits };
+		return (IKeybindFlashRead<word_type>(rKeymap.aAmbiguous.words()[event_idx_ / bits]) >> (event_idx_ % bits)) & 1u;
+	}
+	bool chordKey(size_type key_idx_) const
+	{
+		using word_type = typename Keymap_::key_mask::word_type;
+		const size_t bits{ Keymap_::key_mask::Word_Bits };
+		return (IKeybindFlashRead<word_type>(rKeymap.aChordKey.words()[key_idx_ / bits]) >> (key_idx_ % bits)) & 1u;
+	}
+	size_type bucketBegin(size_type key_idx_) const { return IKeybindFlashRead(rKeymap.aBucketBegin[key_idx_]); }
+	size_type bucketEvent(size_type pos_) const { return IKeybindFlashRead(rKeymap.aBucketEvent[pos_]); }
+	ref_type refBegin(size_type key_idx_) const { return IKeybindFlashRead(rKeymap.aRefBegin[key_idx_]); }
+	size_type refEvent(ref_type pos_) const { return IKeybindFlashRead(rKeymap.aRefEvent[pos_]); }
+	uint16_t keyId(size_type key_idx_) const { return IKeybindFlashRead(rKeymap.aKeyId[key_idx_]); }
+};
+
+
+#if __cplusplus >= 201703L
+/// @brief A keybind definition for `makeKeymap()`.
+struct IKeybindDef
+{
+	size_t                          event_idx;  // Index of the event
+	std::initializer_list<uint16_t> key_id;     // Key IDs of the sequence; the last one is the primary key
+	IPushButton::eState             state;      // Required state of the primary key
+	bool                            unordered{ false };  // True if the keys may be pressed in any order
+};
+
+/// @brief Not constexpr on purpose: reaching it while building a keymap at compile time
+/// stops compilation, and the message shows up in the diagnostic.
+inline void IKeymapError(const char*) {}
+
+/// @brief Builds a keymap at compile time.
+/// Key IDs are resolved against `key_id_`, which lists the IDs of the keys in the order they
+/// are passed to the keybind system; they are kept in the keymap, and `IKeybindStatic` checks
+/// its keys against them. Invalid event indices, sizes or key IDs and events defined twice fail
+/// the build when the result initializes a `constexpr` variable, without exceptions. Evaluated
+/// at runtime instead, invalid definitions are silently left out:
+///
+///     constexpr auto kKeymap = makeKeymap<3, 6>({ D13, D12, D11 }, {
+///         { 0, { D11 }, eKeyState::release },
+///         { 2, { D12, D11 }, eKeyState::rapid },
+///         { 3, { D12, D11 }, eKeyState::push, true },  // Unordered chord
+///     });
+///
+/// @tparam NKey_ The number of keys.
+/// @tparam NEvent_ The maximum number of distinct keybind events.
+/// @tparam KbMax_ The maximum number of keys that can be part of a single keybind sequence.
+/// @tparam NPool_ The total number of keys of all sequences, or 0 to reserve `KbMax_` keys per event.
+/// @param key_id_ The IDs of the keys, in key index order.
+/// @param def_ The keybind definitions.
+/// @return The keymap with its indexes built.
+template < size_t NKey_, size_t NEvent_, size_t KbMax_ = NKey_, size_t NPool_ = 0 >
+constexpr IKeymap<NKey_, NEvent_, KbMax_, NPool_> makeKeymap(const std::array<uint16_t, NKey_>& key_id_, std::initializer_list<IKeybindDef> def_)
+{
+	using keymap_type = IKeymap<NKey_, NEvent_, KbMax_, NPool_>;
+	using size_type = typename keymap_type::size_type;
+
+	keymap_type keymap{};
+	keymap.setKeyIds(key_id_);
+	for (const IKeybindDef& def : def_) {
+		if (def.event_idx >= NEvent_) {
+			IKeymapError("makeKeymap: Event index is out of range.");
+			continue;
+		}
+		if (def.key_id.size() == 0 or def.key_id.size() > KbMax_) {
+			IKeymapError("makeKeymap: Keybind size error.");
+			continue;
+		}
+		if (keymap.size(static_cast<size_type>(def.event_idx))) {
+			IKeymapError("makeKeymap: Event is defined twice.");
+			continue;
+		}
+		if (!keymap.fits(static_cast<size_type>(def.event_idx), def.key_id.size())) {
+			IKeymapError("makeKeymap: Keybind pool is full.");
+			continue;
+		}
+
+		std::array<size_type, KbMax_> key_idx{};
+		size_type n{};
+		for (const uint16_t id : def.key_id) {
+			size_type j{};
+			while (j != NKey_ and key_id_[j] != id) { ++j; }
+			if (j == NKey_) {
+				IKeymapError("makeKeymap: Key ID not found in available keys.");
+				break;
+			}
+			key_idx[n++] = j;
+		}
+		if (n != def.key_id.size()) { continue; }
+		keymap.set(static_cast<size_type>(def.event_idx), key_idx, n, def.state, def.unordered);
+	}
+	keymap.rebuild();
+	return keymap;
+}
+#endif
+
+
+
+//=== Keybind detection engine ===//
+/// @brief Statically polymorphic keybind detection engine (CRTP base).
+/// Provides a robust mechanism to define and detect sequences of key presses (keybinds)
+/// involving multiple keys and specific states. The keys and the keymap are provided by
+/// `Derived_` through `keyArray()` and `keymap()`, so every call is resolved at compile
+/// time and can be inlined; there is no vtable. Use `IKeybind` for a ready-made keybind system.
+/// Derived classes with an editable keymap also provide `editKeymap()`, which `assign()`
+/// and `clear()` write to (see `IKeybindKeymapOwner`). Every derived class provides `commitKeymap()`,
+/// which `update()` calls first; it returns true if the keymap in use changed since the previous call.
+///
+/// @tparam Derived_ The class deriving from this one; it provides `keyArray()` and `keymap()`.
+/// @tparam NKey_ The maximum number of individual keys this keybind system can manage.
+/// @tparam NEvent_ The maximum number of distinct keybind events that can be defined.
+/// @tparam KbMax_ The maximum number of keys that can be part of a single keybind sequence.
+/// @tparam Key_ The key type; it provides `id()`, `state()` (an `IPushButton::eState`), `pushTime()` and `update()`.
+/// @tparam NPool_ The keymap pool size, see `IKeymap`.
+template < typename Derived_, size_t NKey_, size_t NEvent_, size_t KbMax_, typename Key_ = IPushButton, size_t NPool_ = 0 >
+class IKeybindCore
+{
+public:
+	// Type aliases
+	using self_type    = IKeybindCore;
+	using derived_type = Derived_;
+	using keymap_type  = IKeymap<NKey_, NEvent_, KbMax_, NPool_>;
+	using size_type    = typename keymap_type::size_type;
+	using Key          = Key_;
+	using eState       = IPushButton::eState;
+	using id_type    = typename std::decay<decltype(std::declval<const Key&>().id())>::type;
+	using time_type  = decltype(std::declval<const Key&>().pushTime());
+	using ref_type   = typename keymap_type::ref_type;
+	using event_mask = IKeybindBitset<NEvent_>;
+	using key_mask   = IKeybindBitset<NKey_>;
+
+	/// @brief An event reported to the attached event queue.
+	struct FiredEvent
+	{
+		size_type event_idx;  // Index of the detected event
+		eState    state;      // State of the primary key that matched
+		time_type push_time;  // `pushTime()` of the primary key
+	};
+
+	using event_queue_base = IKeybindRingBase<FiredEvent>;
+	template <size_t Capacity_>
+	using event_queue = IKeybindRing<FiredEvent, Capacity_>;
+
+	/// @brief A raw key edge captured outside `update()`, e.g. by a pin-change interrupt.
+	struct KeyEdge
+	{
+		size_type key_idx;  // Index of the key
+		bool      level;    // True if the key went down, false if it went up
+		time_type time;     // Time of the edge, in `pushTime()` units
+	};
+
+	using edge_queue_base = IKeybindSpscBase<KeyEdge>;
+	template <size_t Capacity_>
+	using edge_queue = IKeybindSpsc<KeyEdge, Capacity_>;
+
+	using sequence_base = IKeybindSequenceBase<size_type, time_type>;
+	template <size_t NodeMax_>
+	using sequence = IKeybindSequence<size_type, time_type, NodeMax_>;
+
+	using pattern_base = IKeybindPatternBase<size_type, time_type>;
+	template <size_t NodeMax_>
+	using pattern = IKeybindPattern<size_type, time_type, NodeMax_>;
+
+	using timer_wheel_base = IKeybindTimerWheelBase<size_type, time_type>;
+	template <size_t NSlot_, uint8_t TickShift_ = 0>
+	using timer_wheel = IKeybindTimerWheel<size_type, time_type, NKey_, NSlot_, TickShift_>;
+
+	/// @brief An event handler: a plain function called with its context pointer and the event.
+	using handler_fn = void (*)(void*, const FiredEvent&);
+
+	/// @brief A clock returning the current time in `pushTime()` units, e.g. `millis`.
+	using clock_fn = time_type (*)();
+
+	/// @brief A clock called with its context pointer, e.g. to read a virtual clock object.
+	using clock_ctx_fn = time_type (*)(void*);
+
+	/// @brief A registered event handler, stored without `std::function` or heap.
+	struct EventHandler
+	{
+		handler_fn fn;   // Function to call, or nullptr
+		void*      ctx;  // Context pointer passed back to `fn`
+	};
+
+
+public:
+	// Compile-time constants
+	static const size_type Key_Count{ NKey_ };
+	static const size_type Event_Count{ NEvent_ };
+	static const size_type Keybind_Max{ KbMax_ };
+	static const time_type No_Deadline{ static_cast<time_type>(~time_type(0)) };  // Returned by `nextDeadline()` if nothing is pending
+
+
+private:
+	/// @brief A bitset indicating whether each event has occurred in the current update cycle.
+	/// `aEventOccurred.test(event_idx)` is true if the keybind for that event was detected.
+	event_mask aEventOccurred;
+
+	/// @brief A bitset tracking if a key has been used as a modifier in a detected keybind.
+	/// `aUsedAsModifier.test(key_idx)` is true if the key at `key_idx` was part of a
+	/// successfully detected keybind as a modifier (not the primary key).
+	key_mask aUsedAsModifier;
+
+	/// @brief Keys currently pushed, held or delayed, i.e. usable as modifier.
+	/// Rebuilt by `update()` from the state of every key.
+	key_mask aHeldKeys;
+
+	/// @brief The `state()` of each key as seen by the previous `update()`.
+	std::array<eState, Key_Count> aLastState;
+
+	/// @brief The `pushTime()` of each key as seen by the previous `update()`.
+	std::array<time_type, Key_Count> aLastPushTime;
+
+	/// @brief Keys whose buckets must be searched again by the next `update()`,
+	/// even if their state did not change (e.g. a key newly marked as modifier).
+	key_mask aKeyDirty;
+
+	/// @brief Primary key index -> Index of the event detected for this key.
+	/// Stores (event_index +1), so 0 means "no event found". Kept across updates,
+	/// so only the buckets touched by changed keys have to be searched again.
+	std::array<size_type, Key_Count> aKeyBestEventIdx;
+
+	/// @brief Optional queue that receives every newly detected event, or nullptr.
+	event_queue_base* pEventQueue;
+
+	/// @brief Optional queue of key edges consumed by `update()`, or nullptr.
+	edge_queue_base* pEdgeQueue;
+
+	/// @brief Keys that are not idle or received an edge; with `bSparseScan`, `update()` only scans these.
+	key_mask aAwakeKeys;
+
+	/// @brief True if `update()` only scans awake keys, because every change arrives as an edge or `wakeKeys()`.
+	bool bSparseScan;
+
+	/// @brief Keys that received an edge or were passed to `wakeKeys()` since the previous `update()`.
+	key_mask aWokenKeys;
+
+	/// @brief Keys without `edge()` that received an edge and still read idle. They are scanned every
+	/// update until they leave idle or `settleTime()` passed since the edge, see `scanKey()`.
+	key_mask aSettlingKeys;
+
+	/// @brief Key index -> Time of the edge that made the key settle.
+	std::array<time_type, Key_Count> aSettleSince;
+
+	/// @brief How long a key without `edge()` is scanned after an edge while it reads idle, see `settleTime()`.
+	time_type tSettleTime;
+
+	/// @brief Optional timer wheel of the key deadlines, or nullptr; see `attachTimerWheel()`.
+	timer_wheel_base* pTimerWheel;
+
+	/// @brief Event index -> Handler called when the event is detected.
+	std::array<EventHandler, Event_Count> aHandler;
+
+	/// @brief True if `update()` calls `update()` on every key, false if the keys are updated elsewhere.
+	bool bUpdateKeys;
+
+	/// @brief True if the next `update()` searches every bucket, see `invalidate()`.
+	bool bFullSearch;
+
+	/// @brief Longest time between the first and the last push of an unordered chord, see `chordWindow()`.
+	time_type tChordWindow;
+
+	/// @brief The key IDs in ascending order, and the index of the key with each ID.
+	/// Built once by `indexKeyIds()`, so `keyIdx()` is a binary search instead of a scan of all keys.
+	std::array<id_type, Key_Count> aSortedKeyId;
+	std::array<size_type, Key_Count> aSortedKeyIdx;
+
+	/// @brief Optional trie of sequential keybinds, advanced by every newly detected event, or nullptr.
+	sequence_base* pSequence;
+
+	/// @brief Optional pattern automaton, advanced by every key press, or nullptr.
+	pattern_base* pPattern;
+
+	/// @brief Events raised by a completed sequence or a matched pattern. They are reported for a single update.
+	event_mask aPulseEvent;
+
+	/// @brief Primary key index -> Ambiguous event (+1) detected for this key and not reported yet, see `resolveTimeout()`.
+	std::array<size_type, Key_Count> aDeferredEventIdx;
+
+	/// @brief Keys with a deferred event.
+	key_mask aDeferredKeys;
+
+	/// @brief Clock the timeouts are measured with, see `clock()`, or nullptr.
+	clock_fn pClock;
+
+	/// @brief Clock called with `pClockCtx`, set instead of `pClock`, or nullptr.
+	clock_ctx_fn pClockCtxFn;
+
+	/// @brief The context pointer passed to `pClockCtxFn`.
+	void* pClockCtx;
+
+	/// @brief Longest time an ambiguous event waits for a longer keybind, see `resolveTimeout()`; 0 to not wait.
+	time_type tResolveTimeout;
+
+	/// @brief Key index -> Tap and hold events (+1) of a dual-role key, see `assignTapHold()`; 0 if none.
+	std::array<size_type, Key_Count> aTapEventIdx;
+	std::array<size_type, Key_Count> aHoldEventIdx;
+
+	/// @brief Dual-role keys, see `assignTapHold()`.
+	key_mask aTapHoldKeys;
+
+	/// @brief Dual-role keys pushed and not yet resolved as tap or hold.
+	key_mask aTapHoldPending;
+
+	/// @brief Dual-role keys resolved as hold and still down; their hold event stays reported.
+	key_mask aTapHoldDown;
+
+	/// @brief Key index -> `nPushCount` when the dual-role key was pushed.
+	std::array<uint8_t, Key_Count> aTapHoldPushCount;
+
+	/// @brief Number of key pushes seen by `update()` (wrapping); a pending dual-role key
+	/// sees another key pushed during its hold when it changes.
+	uint8_t nPushCount;
+
+	/// @brief Time a dual-role key must stay down to act as modifier, see `tappingTerm()`.
+	time_type tTappingTerm;
+
+
+private:
+	// Deleted constructors
+	IKeybindCore(const self_type&) = delete;
+	IKeybindCore(self_type&&) = delete;
+
+	/// @brief Gets the key at `key_idx_` from the derived class, without bounds checking.
+	Key& key(size_t key_idx_)
+	{
+		return static_cast<derived_type*>(this)->keyArray()[key_idx_];
+	}
+
+	const Key& key(size_t key_idx_) const
+	{
+		return static_cast<const derived_type*>(this)->keyArray()[key_idx_];
+	}
+
+	/// @brief Converts a key ID to the index of the key, using the table built by `indexKeyIds()`.
+	///
+	/// @return The index of the first key with ID `key_id_`, or `Key_Count` if there is none.
+	size_type keyIdx(id_type key_id_) const
+	{
+		size_type lo{}, hi{ Key_Count };
+		while (lo != hi) {
+			const size_type mid{ static_cast<size_type>(lo + (hi - lo) / 2) };
+			if (aSortedKeyId[mid] < key_id_) { lo = mid + 1; }
+			else { hi = mid; }
+		}
+		return (lo != Key_Count and aSortedKeyId[lo] == key_id_) ? aSortedKeyIdx[lo] : Key_Count;
+	}
+
+	/// @brief Keymap accessors, forwarded to the keymap of the derived class.
+	size_type keybindSize(size_type event_idx_) const { return static_cast<const derived_type*>(this)->keymap().size(event_idx_); }
+	size_type keybindKey(size_type event_idx_, size_type pos_) const { return static_cast<const derived_type*>(this)->keymap().keyIdx(event_idx_, pos_); }
+	eState primaryState(size_type event_idx_) const { return static_cast<const derived_type*>(this)->keymap().primaryState(event_idx_); }
+	bool isUnordered(size_type event_idx_) const { return static_cast<const derived_type*>(this)->keymap().unordered(event_idx_); }
+	bool isAmbiguous(size_type event_idx_) const { return static_cast<const derived_type*>(this)->keymap().ambiguous(event_idx_); }
+	bool isChordKey(size_type key_idx_) const { return static_cast<const derived_type*>(this)->keymap().chordKey(key_idx_); }
+	size_type bucketBegin(size_type key_idx_) const { return static_cast<const derived_type*>(this)->keymap().bucketBegin(key_idx_); }
+	size_type bucketEvent(size_type pos_) const { return static_cast<const derived_type*>(this)->keymap().bucketEvent(pos_); }
+	ref_type refBegin(size_type key_idx_) const { return static_cast<const derived_type*>(this)->keymap().refBegin(key_idx_); }
+	size_type refEvent(ref_type pos_) const { return static_cast<const derived_type*>(this)->keymap().refEvent(pos_); }
+
+	/// @brief Returns the key whose state a detected keybind is matched against: the primary key,
+	/// or for an unordered chord the key pushed last (the primary key on ties), which completed it.
+	///
+	/// @param event_idx_ The index of the keybind event.
+	/// @return The key index.
+	size_type triggerKey(size_type event_idx_) const
+	{
+		size_type trigger{ keybindKey(event_idx_, 0) };
+		if (!isUnordered(event_idx_)) { return trigger; }
+		for (size_type j{ 1 }; j < keybindSize(event_idx_); ++j) {
+			const size_type k{ keybindKey(event_idx_, j) };
+			if (isBefore(key(trigger).pushTime(), key(k).pushTime())) { trigger = k; }
+		}
+		return trigger;
+	}
+
+	/// @brief Checks if all keys in a given keybind sequence are in the correct state and timing.
+	/// This method ensures that modifier keys are held (pushed, held, or delayed) and
+	/// that their push times are in the correct sequence relative to the primary key.
+	/// For an unordered chord, every key but the one pushed last (see `triggerKey()`) must be
+	/// held instead, and the push times must all lie within the chord window.
+	/// The state of all modifiers is checked at once against `aHeldKeys`; the push
+	/// times are only compared for sequences that pass this test.
+	///
+	/// @param event_idx_ The index of the keybind event to validate.
+	/// @return True if the sequence is valid, false otherwise.
+	bool isValidSequence(size_type event_idx_) const
+	{
+		if (isUnordered(event_idx_)) {
+			key_mask held{ static_cast<const derived_type*>(this)->keymap().modifiers(event_idx_) };
+			const size_type trigger{ triggerKey(event_idx_) };
+			if (trigger != keybindKey(event_idx_, 0)) {
+				held.reset(trigger);
+				held.set(keybindKey(event_idx_, 0));
+			}
+			if (!aHeldKeys.includes(held)) { return false; }
+			time_type first{ key(keybindKey(event_idx_, 0)).pushTime() };
+			time_type last{ first };
+			for (size_type j{ 1 }; j < keybindSize(event_idx_); ++j) {
+				const time_type t{ key(keybindKey(event_idx_, j)).pushTime() };
+				if (t < first) { first = t; }
+				if (t > last) { last = t; }
+			}
+			if (static_cast<time_type>(last - first) > tChordWindow) { return false; }
+		}
+		else {
+			if (!aHeldKeys.includes(static_cast<const derived_type*>(this)->keymap().modifiers(event_idx_))) { return false; }
+			for (size_type j{ 1 }; j < keybindSize(event_idx_); ++j) {
+				if (key(keybindKey(event_idx_, j)).pushTime() > key(keybindKey(event_idx_, j - 1)).pushTime()) { return false; }
+			}
+		}
+		return (key(keybindKey(event_idx_, 0)).state() != eState::none);
+	}
+
+	/// @brief Checks if a specific key has been marked as a modifier in a detected keybind.
+	///
+	/// @param key_idx_ The index of the key to check.
+	/// @return True if the key is used as a modifier, false otherwise.
+	bool isUsedAsModifier(size_type key_idx_) const
+	{
+		return (aUsedAsModifier.test(key_idx_));
+	}
+
+	/// @brief Marks all modifier keys within a successfully detected keybind as 'used'.
+	/// This prevents these modifier keys from also being detected as primary keys
+	/// for other keybinds in the same update cycle. For an unordered chord, every key
+	/// but the one that completed it (see `triggerKey()`) acted as modifier.
+	///
+	/// @param event_idx_ The index of the event whose modifiers should be marked.
+	void markModifiersAsUsed(size_type event_idx_)
+	{
+		const size_type trigger{ triggerKey(event_idx_) };
+		for (size_type j{}; j < keybindSize(event_idx_); ++j) {
+			// A newly marked modifier stops acting as primary key from the next update on
+			const size_type k{ keybindKey(event_idx_, j) };
+			if (k != trigger and !aUsedAsModifier.test(k)) {
+				aUsedAsModifier.set(k);
+				aKeyDirty.set(k);
+			}
+		}
+	}
+
+	/// @brief Commits an edited keymap and, if the keymap in use changed, discards every detection result.
+	/// The derived class rebuilds (or swaps in) its keymap; all keys are then searched again by this update.
+	void rebuildIndex()
+	{
+		if (!static_cast<derived_type*>(this)->commitKeymap()) { return; }
+		aKeyBestEventIdx.fill(0);
+		aEventOccurred.reset();
+		aKeyDirty.set();
+		aPulseEvent.reset();
+		aDeferredKeys.reset();
+	}
+
+	/// @brief Searches the bucket of a single primary key for the event to trigger.
+	/// The longest valid sequence wins; among valid sequences of that length the first one
+	/// (in bucket order) whose primary key state (for unordered chords, the state of the key
+	/// pushed last) matches is reported. A key used as modifier only completes unordered
+	/// chords that another key of the chord triggered.
+	///
+	/// @param key_idx_ The index of the primary key whose bucket is searched.
+	/// @param used_ True if the key is used as modifier.
+	/// @return The index of the detected event plus one, or 0 if no event matches.
+	size_type searchBucket(size_type key_idx_, bool used_) const
+	{
+		size_type best_size{};
+		const size_type end{ bucketBegin(key_idx_ +1) };
+		for (size_type p{ bucketBegin(key_idx_) }; p != end; ++p) {
+			const size_type e{ bucketEvent(p) };
+			// A longer valid sequence shadows every shorter one
+			if (keybindSize(e) < best_size) { break; }
+			if (used_ and (!isUnordered(e) or triggerKey(e) == key_idx_)) { continue; }
+			// Ensures all keys are in the correct state
+			if (!isValidSequence(e)) { continue; }
+			best_size = keybindSize(e);
+			// Check primary key state
+			if (primaryState(e) & key(triggerKey(e)).state()) { return e +1; }
+		}
+		return 0;
+	}
+
+	/// @brief Reports a newly detected event to its handler and to the attached event queue.
+	///
+	/// @param event_idx_ The index of the detected event.
+	/// @param key_idx_ The index of the key that triggered it, whose state and push time are reported.
+	void notifyEvent(size_type event_idx_, size_type key_idx_)
+	{
+		if (!aHandler[event_idx_].fn and !pEventQueue) { return; }
+		const FiredEvent event{ event_idx_, key(key_idx_).state(), key(key_idx_).pushTime() };
+		if (aHandler[event_idx_].fn) { aHandler[event_idx_].fn(aHandler[event_idx_].ctx, event); }
+		if (pEventQueue) { pEventQueue->push(event); }
+	}
+
+	/// @brief Advances the attached sequence trie on a newly detected event
+	/// and reports the event of a sequence it completes.
+	///
+	/// @param event_idx_ The index of the detected event.
+	/// @param key_idx_ The index of its primary key.
+	void advanceSequence(size_type event_idx_, size_type key_idx_)
+	{
+		const size_type completed{ pSequence->advance(event_idx_, key(key_idx_).pushTime()) };
+		if (!completed) { return; }
+		aEventOccurred.set(completed -1);
+		aPulseEvent.set(completed -1);
+		notifyEvent(completed -1, key_idx_);
+	}
+
+	/// @brief Advances the attached pattern automaton on a key press
+	/// and reports the event of every pattern the press completes.
+	///
+	/// @param key_idx_ The index of the pressed key.
+	void advancePattern(size_type key_idx_)
+	{
+		pPattern->advance(key_idx_, key(key_idx_).pushTime(), [this, key_idx_](size_type event_idx_) {
+			aEventOccurred.set(event_idx_);
+			aPulseEvent.set(event_idx_);
+			notifyEvent(event_idx_, key_idx_);
+		});
+	}
+
+	/// @brief Passes an edge to a key type that provides `edge(level, time)`.
+	///
+	/// @return True: the key took the edge.
+	template <typename KeyT_>
+	static auto applyEdge(KeyT_& key_, const KeyEdge& edge_, int) -> decltype(key_.edge(edge_.level, edge_.time), bool())
+	{
+		key_.edge(edge_.level, edge_.time);
+		return true;
+	}
+
+	/// @brief Other key types only wake up and read their input in `update()`.
+	///
+	/// @return False: the key may need more updates to read the edge (e.g. while it debounces).
+	template <typename KeyT_>
+	static bool applyEdge(KeyT_&, const KeyEdge&, long) { return false; }
+
+	/// @brief Returns when a key type that provides `deadline()` may next change without input.
+	template <typename KeyT_>
+	static auto keyDeadline(const KeyT_& key_, int) -> decltype(static_cast<time_type>(key_.deadline()))
+	{
+		return static_cast<time_type>(key_.deadline());
+	}
+
+	/// @brief Other active keys may change at any time, so they are due at once.
+	template <typename KeyT_>
+	static time_type keyDeadline(const KeyT_& key_, long)
+	{
+		return key_.pushTime();  // Already passed
+	}
+
+	/// @brief Updates a key and records how it changed since the previous update.
+	/// Resets its 'used as modifier' flag if it's idle or disabled. An idle key stays awake
+	/// while it settles after an edge it could not take, see `settleTime()`.
+	///
+	/// @param key_idx_ The index of the key.
+	void scanKey(size_type key_idx_)
+	{
+		const size_type i{ key_idx_ };
+		if (bUpdateKeys) { key(i).update(); }
+		if (key(i).state() == eState::none
+			or key(i).state() & eState::idle) {
+			if (aUsedAsModifier.test(i)) {
+				aUsedAsModifier.reset(i);
+				aKeyDirty.set(i);
+			}
+			if (aSettlingKeys.test(i) and hasClock()
+				and !isBefore(readClock(), static_cast<time_type>(aSettleSince[i] + tSettleTime))) {
+				aSettlingKeys.reset(i);
+			}
+			if (!aSettlingKeys.test(i)) { aAwakeKeys.reset(i); }
+		}
+		else {
+			aSettlingKeys.reset(i);
+			aAwakeKeys.set(i);
+		}
+		// Keys usable as modifier
+		if (key(i).state() & (eState::push | eState::hold | eState::delay)) {
+			aHeldKeys.set(i);
+		}
+		else {
+			aHeldKeys.reset(i);
+		}
+		// Record keys whose state or push time changed since the previous update
+		if (key(i).state() != aLastState[i]
+			or key(i).pushTime() != aLastPushTime[i]) {
+			aLastState[i] = key(i).state();
+			aLastPushTime[i] = key(i).pushTime();
+			aKeyDirty.set(i);
+			if (key(i).state() & eState::push) {
+				// A new push feeds the pattern automaton and starts resolving a dual-role key
+				if (pPattern) { advancePattern(i); }
+				++nPushCount;
+				if (aTapHoldKeys.test(i)) {
+					aTapHoldPending.set(i);
+					aTapHoldPushCount[i] = nPushCount;
+				}
+			}
+		}
+	}
+
+	/// @brief Calls a member function of the object passed as context.
+	template <typename T_, void (T_::*Fn_)(const FiredEvent&)>
+	static void memberThunk(void* ctx_, const FiredEvent& event_)
+	{
+		(static_cast<T_*>(ctx_)->*Fn_)(event_);
+	}
+
+	/// @brief Reads the clock from a member function of the object passed as context.
+	template <typename T_, time_type (T_::*Fn_)() const>
+	static time_type clockThunk(void* ctx_)
+	{
+		return (static_cast<const T_*>(ctx_)->*Fn_)();
+	}
+
+	/// @brief Core logic for searching and identifying triggered keybind events.
+	/// Only the buckets of primary keys referenced by a dirty key are searched again;
+	/// every other bucket keeps its result from the previous update. Idle keys and keys
+	/// already used as modifier detect nothing. Modifiers are marked after all buckets
+	/// were searched, so detection does not depend on the order of the keys.
+	/// An event is reported as new if its bucket detected something else before,
+	/// or if its primary key changed state or push time in this update. New events
+	/// also advance the attached sequence trie. With a resolution timeout, new ambiguous
+	/// events are deferred instead, see `resolveDeferred()`. Buckets belong to the primary
+	/// keys; an unordered chord is reported with the key that completed it (see `triggerKey()`),
+	/// and shadows the shorter keybinds in the bucket of that key (see `completesChord()`).
+	///
+	/// @param aBucketDirty_ Primary key index -> True if its bucket must be searched again.
+	/// @param aKeyChanged_ Key index -> True if the key changed since the previous update.
+	void searchKeybind(const key_mask& aBucketDirty_, const key_mask& aKeyChanged_)
+	{
+		key_mask aNewEvent;
+		for (size_t i{ aBucketDirty_.findNext(0) }; i != Key_Count; i = aBucketDirty_.findNext(i +1)) {
+			const size_type previous{ aKeyBestEventIdx[i] };
+			// Drop the previous result of this bucket
+			if (aKeyBestEventIdx[i]) {
+				aEventOccurred.reset(aKeyBestEventIdx[i] -1);
+				aKeyBestEventIdx[i] = 0;
+			}
+			// Skip keys without keybinds and idle keys
+			if (bucketBegin(i) == bucketBegin(i +1)) { continue; }
+			if (key(i).state() == eState::none
+				or key(i).state() & eState::idle) {
+				continue;
+			}
+			aKeyBestEventIdx[i] = searchBucket(static_cast<size_type>(i), isUsedAsModifier(i));
+			if (aKeyBestEventIdx[i] and isChordKey(static_cast<size_type>(i))
+				and completesChord(static_cast<size_type>(i), keybindSize(aKeyBestEventIdx[i] -1))) {
+				aKeyBestEventIdx[i] = 0;
+			}
+			if (aKeyBestEventIdx[i]
+				and (aKeyBestEventIdx[i] != previous or aKeyChanged_.test(triggerKey(aKeyBestEventIdx[i] -1)))) {
+				aNewEvent.set(i);
+			}
+		}
+
+		// Mark the detected events as occurred and their modifiers as used
+		for (size_t i{ aBucketDirty_.findNext(0) }; i != Key_Count; i = aBucketDirty_.findNext(i +1)) {
+			if (!aKeyBestEventIdx[i]) { continue; }
+			if (hasClock() and tResolveTimeout and isAmbiguous(aKeyBestEventIdx[i] -1)) {
+				if (aNewEvent.test(i)) { deferEvent(static_cast<size_type>(i)); }
+				continue;
+			}
+			const size_type event_idx{ static_cast<size_type>(aKeyBestEventIdx[i] -1) };
+			markModifiersAsUsed(event_idx);
+			aEventOccurred.set(event_idx);
+			if (!aNewEvent.test(i)) { continue; }
+			notifyEvent(event_idx, triggerKey(event_idx));
+			if (pSequence) { advanceSequence(event_idx, triggerKey(event_idx)); }
+		}
+	}
+
+	/// @brief Returns true if a key completes a longer unordered chord stored in the bucket of
+	/// another key. The chord shadows the keybinds of the key like a longer keybind of its own bucket.
+	///
+	/// @param key_idx_ The index of the key, a modifier of an unordered chord.
+	/// @param size_ The size of the keybind detected in the bucket of the key.
+	bool completesChord(size_type key_idx_, size_type size_) const
+	{
+		const ref_type end{ refBegin(key_idx_ +1) };
+		for (ref_type r{ refBegin(key_idx_) }; r != end; ++r) {
+			const size_type f{ refEvent(r) };
+			if (!isUnordered(f) or keybindSize(f) <= size_ or keybindKey(f, 0) == key_idx_) { continue; }
+			if (triggerKey(f) == key_idx_ and isValidSequence(f)) { return true; }
+		}
+		return false;
+	}
+
+	/// @brief Holds back the ambiguous event just detected for a primary key.
+	/// An event still deferred for the key is resolved first: the key moved on by itself.
+	///
+	/// @param key_idx_ The index of the primary key.
+	void deferEvent(size_type key_idx_)
+	{
+		if (aDeferredKeys.test(key_idx_)) { reportDeferred(key_idx_); }
+		aDeferredEventIdx[key_idx_] = aKeyBestEventIdx[key_idx_];
+		aDeferredKeys.set(key_idx_);
+	}
+
+	/// @brief Returns the key that triggered the event deferred for a primary key.
+	size_type deferredTrigger(size_t key_idx_) const
+	{
+		return triggerKey(static_cast<size_type>(aDeferredEventIdx[key_idx_] -1));
+	}
+
+	/// @brief Reports the deferred event of a key for a single update.
+	///
+	/// @param key_idx_ The index of the primary key.
+	void reportDeferred(size_type key_idx_)
+	{
+		const size_type event_idx{ static_cast<size_type>(aDeferredEventIdx[key_idx_] -1) };
+		aDeferredKeys.reset(key_idx_);
+		markModifiersAsUsed(event_idx);
+		aEventOccurred.set(event_idx);
+		aPulseEvent.set(event_idx);
+		notifyEvent(event_idx, triggerKey(event_idx));
+		if (pSequence) { advanceSequence(event_idx, triggerKey(event_idx)); }
+	}
+
+	/// @brief Resolves deferred events. An event is dropped if a longer keybind took its primary
+	/// key (for an unordered chord, the key that completed it) as modifier, and reported once
+	/// that key is released or the resolution timeout expired.
+	void resolveDeferred()
+	{
+		if (!aDeferredKeys.any()) { return; }
+		const time_type now{ readClock() };
+		for (size_t i{ aDeferredKeys.findNext(0) }; i != Key_Count; i = aDeferredKeys.findNext(i +1)) {
+			const size_type trigger{ deferredTrigger(i) };
+			if (isUsedAsModifier(trigger)) {
+				aDeferredKeys.reset(i);  // The longer keybind won
+			}
+			else if (!hasClock() or !tResolveTimeout or !aHeldKeys.test(trigger)
+				or static_cast<time_type>(now - key(trigger).pushTime()) >= tResolveTimeout) {
+				reportDeferred(static_cast<size_type>(i));
+			}
+		}
+	}
+
+	/// @brief Returns true if a key is down, i.e. pushed and not released yet.
+	bool isDown(size_t key_idx_) const
+	{
+		return key(key_idx_).state() & (eState::push | eState::hold | eState::delay | eState::rapid);
+	}
+
+	/// @brief Resolves the dual-role keys pushed since the last update.
+	/// Only pending and held dual-role keys are visited, each in constant time.
+	/// A pending key acts as modifier (hold) once a keybind used it as modifier, another key was
+	/// pushed after it, or the tapping term expired; released before that, it was a tap.
+	/// The hold event stays reported until the key is released, the tap event for a single update.
+	void resolveTapHold()
+	{
+		for (size_t i{ aTapHoldDown.findNext(0) }; i != Key_Count; i = aTapHoldDown.findNext(i +1)) {
+			if (isDown(i)) { continue; }
+			aTapHoldDown.reset(i);
+			aEventOccurred.reset(aHoldEventIdx[i] -1);
+		}
+		if (!aTapHoldPending.any()) { return; }
+		const time_type now{ readClock() };
+		for (size_t i{ aTapHoldPending.findNext(0) }; i != Key_Count; i = aTapHoldPending.findNext(i +1)) {
+			const bool hold{ isUsedAsModifier(static_cast<size_type>(i))
+				or aTapHoldPushCount[i] != nPushCount
+				or (hasClock() and static_cast<time_type>(now - key(i).pushTime()) >= tTappingTerm) };
+			if (hold) {
+				aTapHoldPending.reset(i);
+				if (!aHoldEventIdx[i]) { continue; }
+				const size_type event_idx{ static_cast<size_type>(aHoldEventIdx[i] -1) };
+				if (isDown(i)) { aTapHoldDown.set(i); }
+				else { aPulseEvent.set(event_idx); }  // Pushed and released within one update
+				aEventOccurred.set(event_idx);
+				notifyEvent(event_idx, static_cast<size_type>(i));
+				if (pSequence) { advanceSequence(event_idx, static_cast<size_type>(i)); }
+			}
+			else if (!isDown(i)) {
+				aTapHoldPending.reset(i);
+				if (!aTapEventIdx[i]) { continue; }
+				const size_type event_idx{ static_cast<size_type>(aTapEventIdx[i] -1) };
+				aEventOccurred.set(event_idx);
+				aPulseEvent.set(event_idx);
+				notifyEvent(event_idx, static_cast<size_type>(i));
+				if (pSequence) { advanceSequence(event_idx, static_cast<size_type>(i)); }
+			}
+		}
+	}
+
+	/// @brief Wrap-around safe `a_ < b_` for times.
+	static bool isBefore(time_type a_, time_type b_)
+	{
+		return static_cast<typename std::make_signed<time_type>::type>(a_ - b_) < 0;
+	}
+
+	/// @brief Arms the timer of a key at its deadline, or disarms it if the key is idle or
+	/// does not change without input.
+	///
+	/// @param key_idx_ The index of the key.
+	void scheduleKey(size_type key_idx_)
+	{
+		const time_type t{ aAwakeKeys.test(key_idx_) ? keyDeadline(key(key_idx_), 0) : No_Deadline };
+		if (t == No_Deadline) { pTimerWheel->cancel(key_idx_); }
+		else { pTimerWheel->schedule(key_idx_, t); }
+	}
+
+
+protected:
+	// Non-virtual destructor, only derived classes are destroyed
+	~IKeybindCore() = default;
+
+	/// @brief Constructor for IKeybindCore.
+	/// All internal arrays for keybind definitions and states are default-initialized (filled with zeros/false).
+	/// The keys are owned by the derived class and must not be accessed here.
+	IKeybindCore() :
+		aEventOccurred{},    // Default-initialize the event occurrence bitset
+		aUsedAsModifier{},   // Default-initialize the used as modifier bitset
+		aHeldKeys{},
+		aLastState{},
+		aLastPushTime{},
+		aKeyDirty{},
+		aKeyBestEventIdx{},
+		pEventQueue{ nullptr },
+		pEdgeQueue{ nullptr },
+		aAwakeKeys{},
+		bSparseScan{ false },
+		aWokenKeys{},
+		aSettlingKeys{},
+		aSettleSince{},
+		tSettleTime{ 50 },
+		pTimerWheel{ nullptr },
+		aHandler{},
+		bUpdateKeys{ true },
+		bFullSearch{ false },
+		tChordWindow{ 50 },
+		aSortedKeyId{},
+		aSortedKeyIdx{},
+		pSequence{ nullptr },
+		pPattern{ nullptr },
+		aPulseEvent{},
+		aDeferredEventIdx{},
+		aDeferredKeys{},
+		pClock{ nullptr },
+		pClockCtxFn{ nullptr },
+		pClockCtx{ nullptr },
+		tResolveTimeout{},
+		aTapEventIdx{},
+		aHoldEventIdx{},
+		aTapHoldKeys{},
+		aTapHoldPending{},
+		aTapHoldDown{},
+		aTapHoldPushCount{},
+		nPushCount{},
+		tTappingTerm{ 200 }
+	{
+		aKeyDirty.set();  // The first update() searches every bucket
+	}
+
+	/// @brief Marks keys as changed by an input source that updates them in bulk (e.g. a key matrix scan).
+	/// From the first call on, `update()` only scans keys woken this way or not idle.
+	///
+	/// @param keys_ The keys whose state changed since the previous `update()`.
+	void wakeKeys(const key_mask& keys_)
+	{
+		aAwakeKeys |= keys_;
+		aWokenKeys |= keys_;
+		bSparseScan = true;
+	}
+
+	/// @brief Returns true if a `clock()` is set.
+	bool hasClock() const { return pClock or pClockCtxFn; }
+
+	/// @brief Reads the `clock()`, or returns 0 without one.
+	time_type readClock() const
+	{
+		if (pClockCtxFn) { return pClockCtxFn(pClockCtx); }
+		return pClock ? pClock() : time_type{};
+	}
+
+	/// @brief Builds the key ID -> key index table used by `assign()`.
+	/// Called by the derived class once its keys are constructed; the IDs must not change afterwards.
+	void indexKeyIds()
+	{
+		// Stable insertion sort by ID, so the first of several keys with the same ID is found
+		for (size_type i{}; i != Key_Count; ++i) {
+			const id_type id{ key(i).id() };
+			size_type q{ i };
+			for (; q > 0 and aSortedKeyId[q -1] > id; --q) {
+				aSortedKeyId[q] = aSortedKeyId[q -1];
+				aSortedKeyIdx[q] = aSortedKeyIdx[q -1];
+			}
+			aSortedKeyId[q] = id;
+			aSortedKeyIdx[q] = i;
+		}
+	}
+
+
+public:
+
+	/// @brief Assigns a key sequence and a primary key state to a specific event index.
+	/// This method defines what constitutes a keybind event.
+	///
+	/// @tparam N The number of key IDs in the `key_id_` array.
+	/// @param event_idx_ The index of the event to which this keybind is being assigned.
+	///                   Must be less than `Event_Count`.
+	/// @param key_id_ An `std::array` of key IDs that form the keybind sequence.
+	///                The last ID in this array is considered the "primary" key.
+	/// @param key_state_ The required `eState` of the primary key for this keybind event to trigger.
+	/// @param unordered_ True if the keys may be pressed in any order, see `assignChord()`.
+	/// @throw std::out_of_range If `event_idx_` is out of bounds, `N` exceeds `Keybind_Max` or the keymap pool is full.
+	/// @throw std::invalid_argument If any `key_id_` is not found in the available keys.
+	template <size_type N>
+	void assign(size_type event_idx_, std::array<id_type, N> key_id_, eState key_state_, bool unordered_ = false)
+	{
+		if (event_idx_ >= Event_Count) {
+			throw std::out_of_range(
+				"IKeybind::assign: Event index is out of range.");
+		}
+		if (N > Keybind_Max) {
+			throw std::out_of_range(
+				"IKeybind::assign: Keybind size error.");
+		}
+
+		std::array<size_type, Keybind_Max> key_idx{};
+		for (size_type i{}; i != N; ++i) {
+			key_idx[i] = keyIdx(key_id_[i]);  // Convert id to idx
+			// If a key ID provided in `key_id_` was not found among the available keys
+			if (key_idx[i] == Key_Count) {
+				throw std::invalid_argument(
+					"IKeybind::assign: Key ID not found in available keys.");
+			}
+		}
+		keymap_type& keymap{ static_cast<derived_type*>(this)->editKeymap() };
+		if (!keymap.fits(event_idx_, N)) {
+			throw std::out_of_range(
+				"IKeybind::assign: Keybind pool is full.");
+		}
+		keymap.set(event_idx_, key_idx, N, key_state_, unordered_);  // Committed by the next update()
+	}
+
+	/// @brief Assigns an unordered chord: the keys may be pressed in any order, as long as
+	/// all of them went down within the chord window (see `chordWindow()`). The key pushed last
+	/// completes the chord: its state triggers the event while the others are held. Replaces
+	/// registering every permutation of the keys with `assign()`.
+	///
+	/// @tparam N The number of key IDs in the `key_id_` array.
+	/// @param event_idx_ The index of the event to which this keybind is being assigned.
+	/// @param key_id_ An `std::array` of key IDs that form the chord; the last one is the primary key.
+	/// @param key_state_ The required `eState` of the key pushed last for this keybind event to trigger.
+	/// @throw std::out_of_range If `event_idx_` is out of bounds, `N` exceeds `Keybind_Max` or the keymap pool is full.
+	/// @throw std::invalid_argument If any `key_id_` is not found in the available keys.
+	template <size_type N>
+	void assignChord(size_type event_idx_, std::array<id_type, N> key_id_, eState key_state_)
+	{
+		assign<N>(event_idx_, key_id_, key_state_, true);
+	}
+
+	/// @brief Assigns a sequence of events, detected one after another, to an event index.
+	/// The steps are events defined with `assign()`, e.g. the chords `C-x` and `C-s`; the
+	/// sequence is compiled into the attached trie right away. Its event is reported for
+	/// the single update in which the last step is detected. An event index should be
+	/// used either for a chord or for a sequence, not both.
+	///
+	/// @tparam N The number of steps in the `step_idx_` array.
+	/// @param event_idx_ The index of the event reported when the sequence completes.
+	/// @param step_idx_ An `std::array` of the event indices of the steps, first step first.
+	/// @throw std::logic_error If no sequence trie is attached.
+	/// @throw std::out_of_range If an event index is out of bounds, `N` is 0 or the trie is full.
+	template <size_type N>
+	void assignSequence(size_type event_idx_, std::array<size_type, N> step_idx_)
+	{
+		if (!pSequence) {
+			throw std::logic_error(
+				"IKeybind::assignSequence: No sequence attached.");
+		}
+		if (event_idx_ >= Event_Count) {
+			throw std::out_of_range(
+				"IKeybind::assignSequence: Event index is out of range.");
+		}
+		if (N == 0) {
+			throw std::out_of_range(
+				"IKeybind::assignSequence: Sequence size error.");
+		}
+		for (auto& it : step_idx_) {
+			if (it >= Event_Count) {
+				throw std::out_of_range(
+					"IKeybind::assignSequence: Step event index is out of range.");
+			}
+		}
+		pSequence->insert(event_idx_, step_idx_.data(), N);
+	}
+
+	/// @brief Assigns a pattern of key presses to an event index.
+	/// The pattern is detected wherever it appears in the stream of key presses, e.g. a
+	/// service code entered after other keys. Its event is reported for the single update
+	/// in which its last key is pressed. An event index should be used either for a chord
+	/// or for a pattern, not both.
+	///
+	/// @tparam N The number of key IDs in the `key_id_` array.
+	/// @param event_idx_ The index of the event reported when the pattern is detected.
+	/// @param key_id_ An `std::array` of key IDs, in the order they are pressed.
+	/// @throw std::logic_error If no pattern automaton is attached.
+	/// @throw std::out_of_range If `event_idx_` is out of bounds, `N` is 0 or the automaton is full.
+	/// @throw std::invalid_argument If any `key_id_` is not found in the available keys.
+	template <size_type N>
+	void assignPattern(size_type event_idx_, std::array<id_type, N> key_id_)
+	{
+		if (!pPattern) {
+			throw std::logic_error(
+				"IKeybind::assignPattern: No pattern attached.");
+		}
+		if (event_idx_ >= Event_Count) {
+			throw std::out_of_range(
+				"IKeybind::assignPattern: Event index is out of range.");
+		}
+		if (N == 0) {
+			throw std::out_of_range(
+				"IKeybind::assignPattern: Pattern size error.");
+		}
+		std::array<size_type, N> key_idx{};
+		for (size_type i{}; i != N; ++i) {
+			key_idx[i] = keyIdx(key_id_[i]);
+			if (key_idx[i] == Key_Count) {
+				throw std::invalid_argument(
+					"IKeybind::assignPattern: Key ID not found in available keys.");
+			}
+		}
+		pPattern->insert(event_idx_, key_idx.data(), N);
+	}
+
+	/// @brief Gets a reference to a key object by its index.
+	///
+	/// @param key_idx_ The index of the key to retrieve.
+	/// @return A reference to the `Key` object at the specified index.
+	/// @throw std::out_of_range If `key_idx_` is out of bounds.
+	Key& getKey(size_type key_idx_)
+	{
+		if (key_idx_ >= Key_Count) {
+			throw std::out_of_range(
+				"IPushButton::getKey: Key index is out of range.");
+		}
+		return key(key_idx_);
+	}
+
+	/// @brief Applies a unary function to each individual key managed by this keybind system.
+	///
+	/// @tparam UnaryFn_ The type of the unary function (e.g., a lambda, function pointer, functor).
+	/// @param fn_ The function to apply. It should take a `Key&` as an argument.
+	template <typename UnaryFn_>
+	void forEachKey(UnaryFn_ fn_)
+	{
+		for (auto& it : static_cast<derived_type*>(this)->keyArray()) { fn_(it); }
+	}
+
+	/// @brief Updates the keys and detects keybind events.
+	/// This method is called repeatedly to update the state of all managed keys
+	/// and then to detect if any defined keybind events have occurred.
+	/// Detection is incremental: keys whose `state()` or `pushTime()` changed mark the
+	/// events referencing them, and only the buckets of those events are searched again.
+	/// With an edge queue attached (or after `wakeKeys()`), only keys that received an edge or are not idle are updated;
+	/// with a timer wheel attached as well, only keys that received an edge or reached their deadline.
+	/// If no key changed, the events of the previous update stay reported,
+	/// except events of completed sequences and matched patterns, which are reported for a single update,
+	/// like deferred ambiguous events (see `resolveTimeout()`).
+	/// Key presses are fed to the pattern automaton in key index order.
+	void update()
+	{
+		// Events of sequences and patterns completed by the previous update expire
+		if (aPulseEvent.any()) {
+			for (size_t i{ aPulseEvent.findNext(0) }; i != Event_Count; i = aPulseEvent.findNext(i +1)) {
+				aEventOccurred.reset(i);
+			}
+			aPulseEvent.reset();
+		}
+
+		// Bring the bucket index up to date after assign()/clear()
+		rebuildIndex();
+
+		if (pEdgeQueue) {
+			// Apply the queued edges; only keys with an edge or still active can change
+			KeyEdge edge;
+			key_mask edged{};
+			while (pEdgeQueue->peek(edge)) {
+				if (edge.key_idx < Key_Count) {
+					// A second edge of a key waits for the next update, so a short tap is seen as push, then release
+					if (edged.test(edge.key_idx)) { break; }
+					edged.set(edge.key_idx);
+					if (!applyEdge(key(edge.key_idx), edge, 0)) {
+						aSettlingKeys.set(edge.key_idx);
+						aSettleSince[edge.key_idx] = edge.time;
+					}
+					aAwakeKeys.set(edge.key_idx);
+					aWokenKeys.set(edge.key_idx);
+				}
+				pEdgeQueue->pop(edge);
+			}
+		}
+		if (bSparseScan and pTimerWheel) {
+			// Only keys woken by input or past their deadline can have changed
+			pTimerWheel->expire(readClock(), [this](size_type key_idx_) { aWokenKeys.set(key_idx_); });
+			aWokenKeys |= aSettlingKeys;
+			for (size_t i{ aWokenKeys.findNext(0) }; i != Key_Count; i = aWokenKeys.findNext(i +1)) {
+				scanKey(static_cast<size_type>(i));
+				scheduleKey(static_cast<size_type>(i));
+			}
+		}
+		else if (bSparseScan) {
+			for (size_t i{ aAwakeKeys.findNext(0) }; i != Key_Count; i = aAwakeKeys.findNext(i +1)) {
+				scanKey(static_cast<size_type>(i));
+			}
+		}
+		else {
+			// Update each individual key
+			for (size_type i{}; i != Key_Count; ++i) { scanKey(i); }
+		}
+		aWokenKeys.reset();
+		// Nothing changed, so the previous detection result still holds
+		if (!aKeyDirty.any() and !bFullSearch) {
+			resolveDeferred();
+			resolveTapHold();
+			return;
+		}
+
+		// Collect the buckets of all events that reference a dirty key
+		const key_mask aKeyChanged{ aKeyDirty };
+		key_mask aBucketDirty;
+		for (size_t i{ aKeyChanged.findNext(0) }; i != Key_Count; i = aKeyChanged.findNext(i +1)) {
+			aBucketDirty.set(i);
+			const ref_type end{ refBegin(i +1) };
+			for (ref_type r{ refBegin(i) }; r != end; ++r) {
+				aBucketDirty.set(keybindKey(refEvent(r), 0));
+				// Any key of an unordered chord may complete it and shadow its own bucket
+				if (isUnordered(refEvent(r))) { aBucketDirty |= static_cast<const derived_type*>(this)->keymap().modifiers(refEvent(r)); }
+			}
+		}
+		aKeyDirty.reset();
+		if (bFullSearch) {
+			aBucketDirty.set();
+			bFullSearch = false;
+		}
+		// Perform the core keybind detection logic
+		searchKeybind(aBucketDirty, aKeyChanged);
+		resolveDeferred();
+		resolveTapHold();
+	}
+
+	/// @brief Checks if a specific keybind event has occurred in the most recent `update()` call.
+	///
+	/// @param event_idx_ The index of the event to check.
+	/// @return True if the specified event occurred, false otherwise. Returns false if `event_idx_` is out of bounds.
+	bool isEvent(size_type event_idx_) const
+	{
+		if (event_idx_ >= Event_Count) { return false; }
+		return aEventOccurred.test(event_idx_);
+	}
+
+	/// @brief Checks if any keybind event has occurred in the most recent `update()` call.
+	///
+	/// @return True if at least one event occurred, false otherwise.
+	bool isAnyEvent() const
+	{
+		return aEventOccurred.any();
+	}
+
+	/// @brief Returns the events that occurred in the most recent `update()` call as a bitset.
+	/// Iterate the occurred events with `findNext()` instead of polling every index:
+	/// `for (auto i = m.findNext(0); i != Event_Count; i = m.findNext(i +1))`.
+	///
+	/// @return A reference to the packed event occurrence flags.
+	const event_mask& eventMask() const
+	{
+		return aEventOccurred;
+	}
+
+	/// @brief Returns the earliest time at which a key can change state on its own (a hold threshold,
+	/// a repeat delay, ...), so the main loop can sleep until then or until a pin interrupt.
+	/// Idle keys only change on input. Active keys report the time through `deadline()` if their type
+	/// provides it (`No_Deadline` for none); otherwise they are due at once. With a timer wheel, the earliest
+	/// armed key deadline is read from the wheel instead of asking every active key. An edge left in the
+	/// edge queue for the next update is due at once. Times are in `pushTime()`
+	/// units; a time that is not in the future means `update()` should run again without sleeping.
+	/// Deferred ambiguous events and pending dual-role keys are due when their timeout expires.
+	///
+	///     const auto deadline = kb.nextDeadline();
+	///     if (deadline != MyKeybind::No_Deadline) { sleepUntil(deadline); } else { sleepUntilInterrupt(); }
+	///
+	/// @return The earliest deadline, or `No_Deadline` if every key is idle.
+	time_type nextDeadline() const
+	{
+		time_type deadline{ No_Deadline };
+		KeyEdge edge;
+		if (pEdgeQueue and pEdgeQueue->peek(edge)) {
+			deadline = edge.time;  // Left queued by the previous update, already due
+		}
+		if (bSparseScan and pTimerWheel) {
+			const time_type t{ pTimerWheel->next() };  // The keys' deadlines are armed in the wheel
+			if (deadline == No_Deadline or (t != No_Deadline and isBefore(t, deadline))) { deadline = t; }
+		}
+		else {
+			for (size_t i{ aAwakeKeys.findNext(0) }; i != Key_Count; i = aAwakeKeys.findNext(i +1)) {
+				const time_type t{ keyDeadline(key(i), 0) };
+				// `No_Deadline` never wins
+				if (t != No_Deadline and (deadline == No_Deadline or isBefore(t, deadline))) { deadline = t; }
+			}
+		}
+		for (size_t i{ aSettlingKeys.findNext(0) }; i != Key_Count; i = aSettlingKeys.findNext(i +1)) {
+			const time_type t{ aSettleSince[i] };  // Already passed
+			if (deadline == No_Deadline or isBefore(t, deadline)) { deadline = t; }
+		}
+		if (!hasClock()) { return deadline; }
+		for (size_t i{ aDeferredKeys.findNext(0) }; i != Key_Count; i = aDeferredKeys.findNext(i +1)) {
+			const time_type t{ static_cast<time_type>(key(deferredTrigger(i)).pushTime() + tResolveTimeout) };
+			if (deadline == No_Deadline or isBefore(t, deadline)) { deadline = t; }
+		}
+		for (size_t i{ aTapHoldPending.findNext(0) }; i != Key_Count; i = aTapHoldPending.findNext(i +1)) {
+			const time_type t{ static_cast<time_type>(key(i).pushTime() + tTappingTerm) };
+			if (deadline == No_Deadline or isBefore(t, deadline)) { deadline = t; }
+		}
+		return deadline;
+	}
+
+	/// @brief Forces the next `update()` to search every bucket, even if no key changed.
+	/// Events that are still detected are not reported to handlers or the queue again.
+	void invalidate()
+	{
+		bFullSearch = true;
+	}
+
+	/// @brief Sets the longest time between the first and the last push of the keys of an
+	/// unordered chord, in `pushTime()` units (50 by default).
+	///
+	/// @param window_ The chord window.
+	void chordWindow(time_type window_)
+	{
+		tChordWindow = window_;
+		bFullSearch = true;  // Chords detected with the previous window are checked again
+	}
+
+	/// @brief Defers ambiguous keybinds until it is clear that no longer keybind completes.
+	/// A keybind is ambiguous if its primary key is also a modifier of a longer keybind that
+	/// contains all its keys (see `IKeymap::ambiguous()`, found when the keymap is indexed).
+	/// Unambiguous keybinds are still reported in the update their primary key changes.
+	/// An ambiguous one is held back while its primary key stays down, and then dropped if the
+	/// longer keybind completes, or reported for a single update once the key is released or
+	/// `timeout_` has passed since it was pushed. Needs a `clock()`. By default (0) ambiguous
+	/// keybinds are reported at once, like all others.
+	///
+	/// @param timeout_ Longest time to wait for a longer keybind, in `pushTime()` units; 0 to not wait.
+	void resolveTimeout(time_type timeout_)
+	{
+		tResolveTimeout = timeout_;  // Events still deferred are reported by the next update() if 0
+	}
+
+	/// @brief Sets the clock that `resolveTimeout()` and `tappingTerm()` are measured with.
+	///
+	///     kb.clock([] { return static_cast<uint32_t>(millis()); });
+	///
+	/// @param clock_ Returns the current time in `pushTime()` units, or nullptr for no clock.
+	void clock(clock_fn clock_)
+	{
+		pClock = clock_;
+		pClockCtxFn = nullptr;
+		pClockCtx = nullptr;
+	}
+
+	/// @brief Sets a clock that is called with a context pointer, replacing any previous clock.
+	///
+	/// @param clock_ Returns the current time in `pushTime()` units, or nullptr for no clock.
+	/// @param ctx_ A pointer passed back to `clock_`.
+	void clock(clock_ctx_fn clock_, void* ctx_)
+	{
+		pClock = nullptr;
+		pClockCtxFn = clock_;
+		pClockCtx = ctx_;
+	}
+
+	/// @brief Reads the time from a member function of `obj_`, e.g. a virtual clock in host
+	/// simulations, so every timeout follows that clock instead of `millis()`.
+	/// Usage: `kb.clock<Sim, &Sim::now>(sim);`
+	///
+	/// @tparam T_ The type of the object.
+	/// @tparam Fn_ The const member function returning the current time.
+	/// @param obj_ The object to call `Fn_` on. It must outlive the registration.
+	template <typename T_, time_type (T_::*Fn_)() const>
+	void clock(T_& obj_)
+	{
+		clock(&clockThunk<T_, Fn_>, &obj_);
+	}
+
+	/// @brief Sets how long a dual-role key must stay down to act as modifier (200 by default),
+	/// see `assignTapHold()`. Measured with the `clock()`; without a clock only other keys and
+	/// keybinds decide.
+	///
+	/// @param term_ The tapping term, in `pushTime()` units.
+	void tappingTerm(time_type term_)
+	{
+		tTappingTerm = term_;
+	}
+
+	/// @brief Makes a key dual-role (mod-tap): tapped, it reports `tap_event_idx_` for a single
+	/// update when it is released; held past the tapping term, or while another key is pushed
+	/// (permissive hold) or a keybind uses it as modifier, it reports `hold_event_idx_` until it
+	/// is released. Keybinds with the key as modifier are detected as usual. Only keys pushed
+	/// since the last update are resolved, in constant time each; no key is polled.
+	///
+	///     kb.assignTapHold(0, 1, D12);  // D12: event 0 when tapped, event 1 (e.g. Shift) when held
+	///
+	/// @param tap_event_idx_ The event reported when the key is tapped.
+	/// @param hold_event_idx_ The event reported while the key acts as modifier.
+	/// @param key_id_ The ID of the key.
+	/// @throw std::out_of_range If an event index is out of bounds.
+	/// @throw std::invalid_argument If `key_id_` is not found in the available keys.
+	void assignTapHold(size_type tap_event_idx_, size_type hold_event_idx_, id_type key_id_)
+	{
+		if (tap_event_idx_ >= Event_Count or hold_event_idx_ >= Event_Count) {
+			throw std::out_of_range(
+				"IKeybind::assignTapHold: Event index is out of range.");
+		}
+		const size_type key_idx{ keyIdx(key_id_) };
+		if (key_idx == Key_Count) {
+			throw std::invalid_argument(
+				"IKeybind::assignTapHold: Key ID not found in available keys.");
+		}
+		aTapEventIdx[key_idx] = static_cast<size_type>(tap_event_idx_ +1);
+		aHoldEventIdx[key_idx] = static_cast<size_type>(hold_event_idx_ +1);
+		aTapHoldKeys.set(key_idx);
+	}
+
+	/// @brief Selects whether `update()` updates the keys before detecting events.
+	/// Turn it off when the keys are shared with other keybind systems or updated elsewhere,
+	/// so that each key is updated exactly once per cycle.
+	///
+	/// @param update_keys_ True to update the keys in `update()` (the default), false to only read them.
+	void updateKeys(bool update_keys_)
+	{
+		bUpdateKeys = update_keys_;
+	}
+
+	/// @brief Attaches a queue that receives every newly detected event.
+	/// Each entry records the event index, the state of its primary key and the primary key's
+	/// `pushTime()`. An event held over several updates is queued once, when it is detected.
+	/// The queue is not owned and must outlive its attachment; pass nullptr to detach it.
+	///
+	/// @param queue_ The queue to fill, e.g. an `event_queue<Capacity>`, or nullptr.
+	void attachQueue(event_queue_base* queue_)
+	{
+		pEventQueue = queue_;
+	}
+
+	/// @brief Attaches the trie that holds the sequences defined with `assignSequence()`.
+	/// Every newly detected event advances it by one step. The trie is not owned and must
+	/// outlive its attachment; pass nullptr to detach it.
+	///
+	/// @param sequence_ The trie to use, e.g. a `sequence<NodeMax>`, or nullptr.
+	void attachSequence(sequence_base* sequence_)
+	{
+		pSequence = sequence_;
+	}
+
+	/// @brief Attaches the automaton that holds the patterns defined with `assignPattern()`.
+	/// Every key press advances it. The automaton is not owned and must outlive its
+	/// attachment; pass nullptr to detach it.
+	///
+	/// @param pattern_ The automaton to use, e.g. a `pattern<NodeMax>`, or nullptr.
+	void attachPattern(pattern_base* pattern_)
+	{
+		pPattern = pattern_;
+	}
+
+	/// @brief Attaches a queue of key edges, filled outside `update()` (e.g. by pin-change interrupts).
+	/// `update()` drains it first and passes each edge to its key with `edge(level, time)` if the key
+	/// type provides it, so state and push time come from the interrupt's timestamp. Idle keys are
+	/// then only updated after an edge, instead of polling every key each cycle. A key gets at most one
+	/// edge per update: a second one stays queued for the next `update()` (see `nextDeadline()`), so a
+	/// press and release captured between two updates are still seen as push, then release. Push one `KeyEdge`
+	/// per change with `queue.push()`; the queue is lock-free for one producer and `update()`.
+	/// The queue is not owned and must outlive its attachment; pass nullptr to detach it.
+	///
+	/// @param queue_ The queue to drain, e.g. an `edge_queue<Capacity>`, or nullptr.
+	void attachEdgeQueue(edge_queue_base* queue_)
+	{
+		pEdgeQueue = queue_;
+		bSparseScan = (queue_ != nullptr);
+		aAwakeKeys.set();  // Scan every key once
+	}
+
+	/// @brief Sets how long a key type without `edge(level, time)` is still scanned after an edge
+	/// while it reads idle (50 by default), e.g. while it debounces the new level. The key leaves
+	/// the scan earlier once it reads anything but idle. Measured with the `clock()`; without a
+	/// clock, the key is scanned until it leaves idle.
+	///
+	/// @param time_ The settle time, in `pushTime()` units.
+	void settleTime(time_type time_)
+	{
+		tSettleTime = time_;
+	}
+
+	/// @brief Attaches a timer wheel that holds the deadline of every active key.
+	/// With an edge queue (or `wakeKeys()`), `update()` then scans only the keys that received an
+	/// edge or whose deadline expired, instead of every key that is not idle, and `nextDeadline()`
+	/// reads the wheel. Keys without `deadline()` are due at once and still scanned every update.
+	/// The wheel is not owned and must outlive its attachment; pass nullptr to detach it.
+	///
+	///     static MyKeybind::timer_wheel<64, 2> wheel;  // 64 slots of 4 ms
+	///     kb.clock([] { return static_cast<uint32_t>(millis()); });
+	///     kb.attachTimerWheel(&wheel);
+	///
+	/// @param wheel_ The wheel to use, e.g. a `timer_wheel<NSlot>`, or nullptr.
+	/// @throw std::logic_error If a wheel is attached without a `clock()`.
+	void attachTimerWheel(timer_wheel_base* wheel_)
+	{
+		if (wheel_ and !hasClock()) {
+			throw std::logic_error(
+				"IKeybind::attachTimerWheel: No clock set.");
+		}
+		pTimerWheel = wheel_;
+		if (!pTimerWheel) { return; }
+		for (size_type i{}; i != Key_Count; ++i) { pTimerWheel->cancel(i); }
+		pTimerWheel->expire(readClock(), [](size_type) {});  // Start turning at the current tick
+		aWokenKeys |= aAwakeKeys;  // Scan the active keys once, which arms their timers
+	}
+
+	/// @brief Registers the handler of an event, replacing any previous one.
+	/// The handler is called from `update()` each time the event is newly detected, the same
+	/// moment it would be queued. `isEvent()` keeps working alongside handlers. Handlers must
+	/// not call `update()`. They are kept by `clear()`.
+	///
+	/// @param event_idx_ The index of the event to handle.
+	/// @param fn_ The function to call, or nullptr to remove the handler.
+	/// @param ctx_ A pointer passed back to `fn_`.
+	/// @throw std::out_of_range If `event_idx_` is out of bounds.
+	void onEvent(size_type event_idx_, handler_fn fn_, void* ctx_ = nullptr)
+	{
+		if (event_idx_ >= Event_Count) {
+			throw std::out_of_range(
+				"IKeybind::onEvent: Event index is out of range.");
+		}
+		aHandler[event_idx_] = { fn_, ctx_ };
+	}
+
+	/// @brief Registers a member function of `obj_` as the handler of an event.
+	/// Usage: `kb.onEvent<Menu, &Menu::select>(event_idx, menu);`
+	///
+	/// @tparam T_ The type of the object.
+	/// @tparam Fn_ The member function to call; it takes a `const FiredEvent&`.
+	/// @param event_idx_ The index of the event to handle.
+	/// @param obj_ The object to call `Fn_` on. It must outlive the registration.
+	/// @throw std::out_of_range If `event_idx_` is out of bounds.
+	template <typename T_, void (T_::*Fn_)(const FiredEvent&)>
+	void onEvent(size_type event_idx_, T_& obj_)
+	{
+		onEvent(event_idx_, &memberThunk<T_, Fn_>, &obj_);
+	}
+
+	/// @brief Clears all defined keybinds and resets internal state arrays.
+	/// This unassigns all events and prepares the `IKeybind` object for new keybind definitions.
+	/// The sequences and patterns of attached tries and the dual-role keys are removed as well.
+	void clear()
+	{
+		static_cast<derived_type*>(this)->editKeymap().clear();  // Committed by the next update()
+		aEventOccurred   .reset();
+		aUsedAsModifier  .reset();
+		aKeyBestEventIdx .fill({});
+		aKeyDirty        .reset();
+		aPulseEvent      .reset();
+		aDeferredKeys    .reset();
+		aTapEventIdx     .fill({});
+		aHoldEventIdx    .fill({});
+		aTapHoldKeys     .reset();
+		aTapHoldPending  .reset();
+		aTapHoldDown     .reset();
+		if (pSequence) { pSequence->clear(); }
+		if (pPattern) { pPattern->clear(); }
+	}
+
+};
+
+
+
+/// @brief An editable keymap for a keybind system, the common part of `IKeybind`,
+/// `IKeybindView` and `IKeybindMatrix`. Provides `keymap()`, `editKeymap()` and `commitKeymap()`
+/// to `IKeybindCore` (a friend of the derived class): edits mark the keymap stale, and the
+/// next `update()` rebuilds its indexes once, however many keybinds were assigned.
+///
+/// @tparam Keymap_ The keymap type, an `IKeymap` instantiation.
+template < typename Keymap_ >
+class IKeybindKeymapOwner
+{
+private:
+	/// @brief The keybind definitions, edited by `assign()` and `clear()`.
+	Keymap_ oKeymap;
+
+	/// @brief True if `assign()` or `clear()` changed the keymap since it was committed.
+	bool bKeymapStale;
+
+
+protected:
+	IKeybindKeymapOwner() :
+		oKeymap{},
+		bKeymapStale{ false }
+	{}
+
+	const Keymap_& keymap() const { return oKeymap; }
+	Keymap_& editKeymap()
+	{
+		bKeymapStale = true;
+		return oKeymap;
+	}
+	bool commitKeymap()
+	{
+		if (!bKeymapStale) { return false; }
+		oKeymap.rebuild();
+		bKeymapStale = false;
+		return true;
+	}
+};
+
+
+
+/// @brief A templated class for managing and detecting complex keybinds.
+/// Owns its keys and inherits the whole keybind logic from `IKeybindCore`.
+/// The class is `final` and its interface is non-virtual, so calls like `isEvent()`
+/// inline into the caller. Wrap it in an `IKeybindHandle` where an `IKeybindBase`
+/// (runtime polymorphism) is needed.
+///
+/// @tparam NKey_ The maximum number of individual keys this keybind system can manage.
+/// @tparam NEvent_ The maximum number of distinct keybind events that can be defined.
+/// @tparam KbMax_ The maximum number of keys that can be part of a single keybind sequence.
+/// @tparam NPool_ The total number of keys of all keybinds, or 0 to reserve `KbMax_` keys per event (see `IKeymap`).
+template < size_t NKey_, size_t NEvent_, size_t KbMax_ = NKey_, size_t NPool_ = 0 >
+class IKeybind final : public IKeybindCore<IKeybind<NKey_, NEvent_, KbMax_, NPool_>, NKey_, NEvent_, KbMax_, IPushButton, NPool_>,
+	public IKeybindKeymapOwner<IKeymap<NKey_, NEvent_, KbMax_, NPool_>>
+{
+public:
+	// Type aliases
+	using self_type  = IKeybind;
+	using base_type  = IKeybindCore<IKeybind, NKey_, NEvent_, KbMax_, IPushButton, NPool_>;
+	using keymap_base = IKeybindKeymapOwner<typename base_type::keymap_type>;
+	using Key        = typename base_type::Key;
+	using keymap_type = typename base_type::keymap_type;
+
+	friend base_type;
+
+
+private:
+	/// @brief  An array holding all the individual key objects.
+	std::array<Key, NKey_> aKey;
+
+	/// @brief Provides the keys to `IKeybindCore`; the keymap comes from `IKeybindKeymapOwner`.
+	std::array<Key, NKey_>& keyArray() { return aKey; }
+	const std::array<Key, NKey_>& keyArray() const { return aKey; }
+
+
+public:
+	// Default destructor
+	~IKeybind() = default;
+
+	/// @brief Constructor for IKeybind.
+	/// Initializes the keybind system with an array of individual key objects.
+	///
+	/// @param keys_ An `std::array` containing all the `IPushButton` objects this keybind system will manage.
+	IKeybind(std::array<Key, NKey_> keys_) :
+		base_type(),
+		keymap_base(),
+		aKey{ keys_ }  // Initialize the array of keys with the provided keys
+	{
+		this->indexKeyIds();
+	}
+};
+
+
+
+/// @brief Type-erased handle that exposes a keybind system through `IKeybindBase`.
+/// Opt-in runtime polymorphism: only code that stores keybind systems of different
+/// types behind one interface pays for the virtual calls.
+///
+/// @tparam Keybind_ The keybind system type, e.g. an `IKeybind` instantiation.
+template < typename Keybind_ >
+class IKeybindHandle final : public IKeybindBase
+{
+public:
+	// Type aliases
+	using self_type     = IKeybindHandle;
+	using keybind_type  = Keybind_;
+
+
+private:
+	/// @brief The keybind system all calls are forwarded to; not owned.
+	Keybind_& rKeybind;
+
+
+public:
+	/// @brief Constructor for IKeybindHandle.
+	///
+	/// @param keybind_ The keybind system to expose. It must outlive the handle.
+	explicit IKeybindHandle(Keybind_& keybind_) :
+		rKeybind{ keybind_ }
+	{}
+
+	/// @brief Overrides IKeybindBase::update().
+	void update() override { rKeybind.update(); }
+
+	/// @brief Overrides IKeybindBase::isEvent().
+	bool isEvent(size_type event_idx_) const override
+	{
+		return event_idx_ < Keybind_::Event_Count and rKeybind.isEvent(static_cast<typename Keybind_::size_type>(event_idx_));
+	}
+
+	/// @brief Overrides IKeybindBase::isAnyEvent().
+	bool isAnyEvent() const override { return rKeybind.isAnyEvent(); }
+
+	/// @brief Gets the wrapped keybind system.
+	Keybind_& get() const { return rKeybind; }
+};
+
+
+
+/// @brief A keybind system that evaluates keys owned by the caller.
+/// Holds a reference to the key array instead of a copy, so several keybind systems
+/// (e.g. one keymap per mode) can evaluate the same physical keys without duplicating
+/// their state. Only one of them should update the keys; construct the others with
+/// `update_keys_ = false`, or update the keys yourself and disable it for all of them.
+///
+/// @tparam NKey_ The number of keys in the referenced array.
+/// @tparam NEvent_ The maximum number of distinct keybind events that can be defined.
+/// @tparam KbMax_ The maximum number of keys that can be part of a single keybind sequence.
+/// @tparam NPool_ The total number of keys of all keybinds, or 0 to reserve `KbMax_` keys per event (see `IKeymap`).
+template < size_t NKey_, size_t NEvent_, size_t KbMax_ = NKey_, size_t NPool_ = 0 >
+class IKeybindView final : public IKeybindCore<IKeybindView<NKey_, NEvent_, KbMax_, NPool_>, NKey_, NEvent_, KbMax_, IPushButton, NPool_>,
+	public IKeybindKeymapOwner<IKeymap<NKey_, NEvent_, KbMax_, NPool_>>
+{
+public:
+	// Type aliases
+	using self_type  = IKeybindView;
+	using base_type  = IKeybindCore<IKeybindView, NKey_, NEvent_, KbMax_, IPushButton, NPool_>;
+	using keymap_base = IKeybindKeymapOwner<typename base_type::keymap_type>;
+	using Key        = typename base_type::Key;
+	using keymap_type = typename base_type::keymap_type;
+
+	friend base_type;
+
+
+private:
+	/// @brief The caller-owned keys; not owned.
+	std::array<Key, NKey_>& rKey;
+
+	/// @brief Provides the keys to `IKeybindCore`; the keymap comes from `IKeybindKeymapOwner`.
+	std::array<Key, NKey_>& keyArray() { return rKey; }
+	const std::array<Key, NKey_>& keyArray() const { return rKey; }
+
+
+public:
+	// Default destructor
+	~IKeybindView() = default;
+
+	/// @brief Constructor for IKeybindView.
+	///
+	/// @param keys_ The keys to evaluate. They must outlive the keybind system.
+	/// @param update_keys_ True if `update()` updates the keys, false if they are updated elsewhere.
+	explicit IKeybindView(std::array<Key, NKey_>& keys_, bool update_keys_ = true) :
+		base_type(),
+		keymap_base(),
+		rKey{ keys_ }
+	{
+		this->indexKeyIds();
+		this->updateKeys(update_keys_);
+	}
+};
+
+
+
+/// @brief A keybind system whose keymap can be remapped from another context while `update()` runs.
+/// Double-buffered: `assign()` and `clear()` edit a staging keymap, and `publish()` indexes it and
+/// hands it over with a single atomic store. `update()` swaps it in at the start of the next cycle,
+/// so detection never sees a half-written binding and neither side waits for the other.
+/// One context edits and publishes (e.g. a host thread or an interrupt), one context calls `update()`.
+/// After `publish()`, edits are refused until `update()` has swapped the keymap in (see `pending()`).
+/// Sequences and patterns of attached tries are not double-buffered.
+///
+/// @tparam NKey_ The maximum number of individual keys this keybind system can manage.
+/// @tparam NEvent_ The maximum number of distinct keybind events that can be defined.
+/// @tparam KbMax_ The maximum number of keys that can be part of a single keybind sequence.
+/// @tparam NPool_ The total number of keys of all keybinds, or 0 to reserve `KbMax_` keys per event (see `IKeymap`).
+template < size_t NKey_, size_t NEvent_, size_t KbMax_ = NKey_, size_t NPool_ = 0 >
+class IKeybindLive final : public IKeybindCore<IKeybindLive<NKey_, NEvent_, KbMax_, NPool_>, NKey_, NEvent_, KbMax_, IPushButton, NPool_>
+{
+public:
+	// Type aliases
+	using self_type  = IKeybindLive;
+	using base_type  = IKeybindCore<IKeybindLive, NKey_, NEvent_, KbMax_, IPushButton, NPool_>;
+	using Key        = typename base_type::Key;
+	using keymap_type = typename base_type::keymap_type;
+
+	friend base_type;
+
+
+private:
+	/// @brief  An array holding all the individual key objects.
+	std::array<Key, NKey_> aKey;
+
+	/// @brief The keymap in use and the staging keymap.
+	std::array<keymap_type, 2> aKeymap;
+
+	/// @brief The keymap `update()` reads. Only touched by the updating context.
+	const keymap_type* pActive;
+
+	/// @brief Index of the keymap in use, stored by `update()` when it swaps.
+	IKeybindAtomic<uint8_t> nActive;
+
+	/// @brief Index of the keymap published last, stored by `publish()`.
+	IKeybindAtomic<uint8_t> nPublished;
+
+	/// @brief False if the staging keymap must be copied from the published one before the next edit.
+	/// Only touched by the editing context.
+	bool bStagingSynced;
+
+	/// @brief Provides the keys and the keymap to `IKeybindCore`.
+	std::array<Key, NKey_>& keyArray() { return aKey; }
+	const std::array<Key, NKey_>& keyArray() const { return aKey; }
+	const keymap_type& keymap() const { return *pActive; }
+
+	/// @brief Returns the staging keymap, the one not published.
+	/// @throw std::logic_error If the previous `publish()` has not been swapped in yet.
+	keymap_type& editKeymap()
+	{
+		if (pending()) {
+			throw std::logic_error(
+				"IKeybindLive::editKeymap: Published keymap not swapped in yet.");
+		}
+		keymap_type& staging{ aKeymap[1 - nPublished.load()] };
+		if (!bStagingSynced) {
+			staging = aKeymap[nPublished.load()];
+			bStagingSynced = true;
+		}
+		return staging;
+	}
+
+	/// @brief Swaps in a newly published keymap.
+	bool commitKeymap()
+	{
+		const uint8_t published{ nPublished.load() };
+		if (&aKeymap[published] == pActive) { return false; }
+		pActive = &aKeymap[published];
+		nActive.store(published);
+		return true;
+	}
+
+
+public:
+	// Default destructor
+	~IKeybindLive() = default;
+
+	/// @brief Constructor for IKeybindLive.
+	///
+	/// @param keys_ An `std::array` containing all the `IPushButton` objects this keybind system will manage.
+	IKeybindLive(std::array<Key, NKey_> keys_) :
+		base_type(),
+		aKey{ keys_ },
+		aKeymap{},
+		pActive{ &aKeymap[0] },
+		nActive{ 0 },
+		nPublished{ 0 },
+		bStagingSynced{ true }
+	{
+		this->indexKeyIds();
+	}
+
+	/// @brief Indexes the staging keymap and publishes it; the next `update()` uses it.
+	/// The indexing runs in the calling context, not in `update()`.
+	///
+	/// @throw std::logic_error If the previous `publish()` has not been swapped in yet.
+	void publish()
+	{
+		keymap_type& staging{ editKeymap() };
+		staging.rebuild();
+		bStagingSynced = false;
+		nPublished.store(static_cast<uint8_t>(&staging - aKeymap.data()));
+	}
+
+	/// @brief Returns true while a published keymap waits for `update()` to swap it in.
+	bool pending() const
+	{
+		return nPublished.load() != nActive.load();
+	}
+
+	/// @brief Removes all keybinds from the staging keymap; see `publish()`.
+	/// Unlike `IKeybindCore::clear()`, detection state and attached tries are left alone.
+	void clear()
+	{
+		editKeymap().clear();
+	}
 };
 
 
 
+#if __cplusplus >= 201703L
+/// @brief A keybind system that evaluates a keymap built at compile time.
+/// The keymap is a `constexpr` `IKeymap` (see `makeKeymap()`) passed by reference as template
+/// argument, so it stays in flash/rodata and costs no RAM and no setup time; only the detection
+/// state lives in the object. On AVR, declare the keymap `PROGMEM`; it is read with `memcpy_P`.
+/// `assign()` and `clear()` are not available. Nothing throws: `valid()` tells if the keys were
+/// passed in the order of the key IDs the keymap was built with.
+///
+///     static constexpr auto kKeymap PROGMEM = makeKeymap<3, 6>({ D13, D12, D11 }, { ... });
+///     IKeybindStatic<kKeymap> kb({ { {D13, INPUT_PULLUP}, {D12, INPUT_PULLUP}, {D11, INPUT_PULLUP} } });
+///     // in setup(): if (!kb.valid()) { ... }
+///
+/// @tparam Keymap_ The keymap, an object with static storage duration.
+template < const auto& Keymap_ >
+class IKeybindStatic final : public IKeybindCore<IKeybindStatic<Keymap_>,
+	std::decay_t<decltype(Keymap_)>::Key_Count,
+	std::decay_t<decltype(Keymap_)>::Event_Count,
+	std::decay_t<decltype(Keymap_)>::Keybind_Max,
+	IPushButton,
+	std::decay_t<decltype(Keymap_)>::Pool_Size>
+{
+public:
+	// Type aliases
+	using self_type   = IKeybindStatic;
+	using keymap_type = std::decay_t<decltype(Keymap_)>;
+	using base_type   = IKeybindCore<IKeybindStatic, keymap_type::Key_Count, keymap_type::Event_Count, keymap_type::Keybind_Max, IPushButton, keymap_type::Pool_Size>;
+	using Key         = typename base_type::Key;
+
+	friend base_type;
+
+
+private:
+	/// @brief  An array holding all the individual key objects.
+	std::array<Key, keymap_type::Key_Count> aKey;
+
+	/// @brief Provides the keys and the keymap to `IKeybindCore`.
+	std::array<Key, keymap_type::Key_Count>& keyArray() { return aKey; }
+	const std::array<Key, keymap_type::Key_Count>& keyArray() const { return aKey; }
+#if defined(__AVR__)
+	IKeymapProgmem<keymap_type> keymap() const { return IKeymapProgmem<keymap_type>(Keymap_); }
+#else
+	const keymap_type& keymap() const { return Keymap_; }
+#endif
+	bool commitKeymap() { return false; }  // The keymap is built at compile time
+
+
+public:
+	// Default destructor
+	~IKeybindStatic() = default;
+
+	/// @brief Constructor for IKeybindStatic.
+	///
+	/// @param keys_ The keys, in the order of the key IDs the keymap was built with (see `valid()`).
+	IKeybindStatic(std::array<Key, keymap_type::Key_Count> keys_) :
+		base_type(),
+		aKey{ keys_ }
+	{
+		this->indexKeyIds();
+	}
+
+	/// @brief Checks the keys against the key IDs passed to `makeKeymap()`.
+	/// With keys in another order, the keybinds are evaluated on the wrong keys.
+	///
+	/// @return True if every key has the ID the keymap expects at its index.
+	bool valid() const
+	{
+		for (size_t i{}; i != keymap_type::Key_Count; ++i) {
+			if (static_cast<uint16_t>(aKey[i].id()) != keymap().keyId(static_cast<typename keymap_type::size_type>(i))) { return false; }
+		}
+		return true;
+	}
+};
+#endif
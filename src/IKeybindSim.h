@@ -0,0 +1,151 @@
+#pragma once
+#include <stddef.h> // For size_t
+#include <type_traits> // For std::make_signed
+#include "IKeybind.h"
+
+
+
+//=== Virtual-time simulation ===//
+/// @brief Replays scripted key edges through a keybind system in virtual time, for host tests
+/// and benchmarks. The driver becomes the keybind's `clock()` and feeds the edges through an
+/// edge queue, so keys that provide `edge(level, time)` take their push times from the script.
+/// Instead of sleeping, `runUntil()` jumps straight to the next scripted edge or `nextDeadline()`
+/// and calls `update()` there, so hours of input replay in the time their updates take, and the
+/// same script always gives the same updates and events.
+///
+/// Keys that are polled (without `deadline()`, or a key matrix that debounces every scan) are
+/// due at once while active; the driver then steps by the poll period. `advance()` updates at a
+/// fixed step, e.g. to scan a simulated matrix port the test changes between steps.
+///
+///     IKeybindSim<MyKeybind> sim(kb);
+///     sim.play(script.data(), script.size());  // KeyEdges sorted by time
+///     sim.runUntil(3600000);                   // One hour of input
+///
+/// @tparam Keybind_ The keybind system type, e.g. `IKeybind<...>`.
+/// @tparam NEdge_ The capacity of the edge queue, i.e. the most edges delivered to one update.
+template < typename Keybind_, size_t NEdge_ = 32 >
+class IKeybindSim
+{
+public:
+	// Type aliases
+	using keybind_type = Keybind_;
+	using time_type    = typename Keybind_::time_type;
+	using KeyEdge      = typename Keybind_::KeyEdge;
+
+
+private:
+	keybind_type&                                        rKeybind;      // The simulated keybind system
+	typename keybind_type::template edge_queue<NEdge_>   oEdges;        // Edges due by the next update
+	const KeyEdge*                                       pScript;       // Scripted edges, sorted by time
+	size_t                                               nScriptSize;   // Number of scripted edges
+	size_t                                               nScriptPos;    // Next edge to deliver
+	time_type                                            tNow;          // Virtual time
+	time_type                                            tPollPeriod;   // Step while a key is due at once
+	size_t                                               nUpdateCount;  // update() calls so far
+
+
+	/// @brief Wrap-around safe `a_ < b_` for times.
+	static bool isBefore(time_type a_, time_type b_)
+	{
+		return static_cast<typename std::make_signed<time_type>::type>(a_ - b_) < 0;
+	}
+
+	/// @brief Moves the scripted edges due by now into the queue and updates the keybind system.
+	void updateAt(time_type now_)
+	{
+		tNow = now_;
+		while (nScriptPos != nScriptSize and !isBefore(tNow, pScript[nScriptPos].time)) {
+			if (!oEdges.push(pScript[nScriptPos])) { break; }  // The rest is delivered by the next update
+			++nScriptPos;
+		}
+		rKeybind.update();
+		++nUpdateCount;
+	}
+
+
+public:
+	// Not copyable: the keybind system keeps pointers to the clock and the queue
+	IKeybindSim(const IKeybindSim&) = delete;
+	IKeybindSim& operator=(const IKeybindSim&) = delete;
+
+	/// @brief Detaches the clock and the queue from the keybind system.
+	~IKeybindSim()
+	{
+		rKeybind.clock(nullptr);
+		rKeybind.attachEdgeQueue(nullptr);
+	}
+
+	/// @brief Constructor for IKeybindSim. Sets the driver as clock and edge queue of `keybind_`.
+	///
+	/// @param keybind_ The keybind system to drive. It must outlive the driver.
+	/// @param start_ The virtual time to start at.
+	/// @param poll_period_ The step while an active key has no deadline, at least 1.
+	explicit IKeybindSim(keybind_type& keybind_, time_type start_ = 0, time_type poll_period_ = 1) :
+		rKeybind{ keybind_ },
+		oEdges{},
+		pScript{ nullptr },
+		nScriptSize{},
+		nScriptPos{},
+		tNow{ start_ },
+		tPollPeriod{ poll_period_ ? poll_period_ : time_type{ 1 } },
+		nUpdateCount{}
+	{
+		rKeybind.template clock<IKeybindSim, &IKeybindSim::now>(*this);
+		rKeybind.attachEdgeQueue(&oEdges);
+	}
+
+	/// @brief Returns the virtual time; the keybind system's clock.
+	time_type now() const { return tNow; }
+
+	/// @brief Returns the number of `update()` calls made so far.
+	size_t updateCount() const { return nUpdateCount; }
+
+	/// @brief Returns true if every scripted edge was delivered.
+	bool finished() const { return nScriptPos == nScriptSize; }
+
+	/// @brief Sets the edges to replay, replacing any that were not delivered yet.
+	/// Edges older than the virtual time are delivered by the next update.
+	///
+	/// @param script_ The edges, sorted by time. The array must outlive the replay.
+	/// @param size_ The number of edges.
+	void play(const KeyEdge* script_, size_t size_)
+	{
+		pScript = script_;
+		nScriptSize = size_;
+		nScriptPos = 0;
+	}
+
+	/// @brief Advances the virtual time by `step_` and updates once.
+	///
+	/// @param step_ The time to advance by.
+	void advance(time_type step_)
+	{
+		updateAt(static_cast<time_type>(tNow + step_));
+	}
+
+	/// @brief Replays until `end_`: updates at every scripted edge and every `nextDeadline()`
+	/// up to `end_`, skipping the time in between. The virtual time is `end_` afterwards.
+	///
+	/// @param end_ The virtual time to stop at.
+	void runUntil(time_type end_)
+	{
+		for (;;) {
+			bool due{ false };
+			time_type next{ end_ };
+			if (nScriptPos != nScriptSize) {
+				time_type t{ pScript[nScriptPos].time };
+				if (isBefore(t, tNow)) { t = tNow; }
+				if (!isBefore(next, t)) { next = t; due = true; }
+			}
+			time_type deadline{ rKeybind.nextDeadline() };
+			if (deadline != keybind_type::No_Deadline) {
+				// Due at once: step by the poll period, so time always moves on
+				if (!isBefore(tNow, deadline)) { deadline = static_cast<time_type>(tNow + tPollPeriod); }
+				if (!isBefore(next, deadline) and (!due or isBefore(deadline, next))) { next = deadline; due = true; }
+			}
+			if (!due) { break; }
+			updateAt(next);
+		}
+		tNow = end_;
+	}
+};
@@ -0,0 +1,74 @@
+// Minimal checks and scripting helpers for the host tests: each failed CHECK() prints its
+// location, and the test returns non-zero from main() through testResult(). Each test is one
+// translation unit, so the helpers are defined here.
+#pragma once
+#include <cstdio>
+#include <stddef.h> // For size_t
+#include <stdint.h> // For uint32_t
+
+inline int gFailed{};
+
+/// @brief Returns the exit code of a test: 0 if every check passed.
+inline int testResult()
+{
+	if (gFailed) { std::fprintf(stderr, "%d check(s) failed\n", gFailed); }
+	return gFailed ? 1 : 0;
+}
+
+#define CHECK(cond_) \
+	do { \
+		if (!(cond_)) { \
+			std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond_); \
+			++gFailed; \
+		} \
+	} while (0)
+
+
+
+//=== Scripting ===//
+/// @brief The test clock: set `gNow`, then update. Pass `now` to `clock()`.
+inline uint32_t gNow{};
+
+inline uint32_t now() { return gNow; }
+
+/// @brief Times each event was reported to `count()`, by event index.
+inline int gFired[64]{};
+
+/// @brief Event handler that counts into `gFired`: `kb.onEvent(e, count<KB::FiredEvent>)`.
+template < typename FiredEvent_ >
+void count(void*, const FiredEvent_& event_) { ++gFired[event_.event_idx]; }
+
+/// @brief Returns the events of the last update as bits (the first 32 events).
+template < typename Keybind_ >
+uint32_t events(const Keybind_& kb_)
+{
+	return static_cast<uint32_t>(kb_.eventMask().words()[0]);
+}
+
+/// @brief Updates at `now_` without input and returns the reported events.
+template < typename Keybind_ >
+uint32_t wait(Keybind_& kb_, uint32_t now_)
+{
+	gNow = now_;
+	kb_.update();
+	return events(kb_);
+}
+
+/// @brief Sets the state and push time of a key, updates at `now_` and returns the reported events.
+template < typename Keybind_ >
+uint32_t step(Keybind_& kb_, uint32_t now_, size_t key_idx_, typename Keybind_::eState state_, uint32_t push_time_)
+{
+	kb_.getKey(key_idx_).set(state_, push_time_);
+	return wait(kb_, now_);
+}
+
+/// @brief Pushes a key at `time_` and makes it idle again with a second update.
+///
+/// @return The events reported when the key was pushed.
+template < typename Keybind_ >
+uint32_t tap(Keybind_& kb_, size_t key_idx_, uint32_t time_)
+{
+	const uint32_t pushed{ step(kb_, time_, key_idx_, Keybind_::eState::push, time_) };
+	step(kb_, time_, key_idx_, Keybind_::eState::idle, time_);
+	return pushed;
+}
@@ -0,0 +1,81 @@
+// Unordered chords: the keys go down in any order within the chord window, and the state is
+// matched on the key pushed last.
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<3, 4, 2>;
+using eState = KB::eState;
+
+/// @brief Presses `first_` at 100 and `second_` at `100 + gap_`, holds both and releases
+/// `second_`; returns how often event 0 was reported.
+int play(eState state_, size_t first_, size_t second_, uint32_t gap_)
+{
+	static KB kb({ { { 10, 0 }, { 11, 0 }, { 12, 0 } } });
+	kb.clear();
+	for (size_t k{}; k != 3; ++k) { kb.getKey(k).set(eState::idle, 0); }
+	kb.assignChord<2>(0, { 10, 11 }, state_);
+	kb.update();
+
+	const uint32_t t{ 100 + gap_ };
+	int fired{};
+	kb.getKey(first_).set(eState::push, 100);  kb.update(); fired += kb.isEvent(0);
+	kb.getKey(first_).set(eState::delay, 100); kb.update(); fired += kb.isEvent(0);
+	kb.getKey(second_).set(eState::push, t);   kb.update(); fired += kb.isEvent(0);
+	kb.getKey(second_).set(eState::delay, t);  kb.update(); fired += kb.isEvent(0);
+	kb.getKey(second_).set(eState::release, t); kb.update(); fired += kb.isEvent(0);
+	return fired;
+}
+
+/// @brief Completes the chord { 10, 11 } by pushing `last_` after `first_`, with release
+/// bindings on both keys alone, and checks that the key pushed last is reported and stays free.
+void checkTrigger(size_t first_, size_t last_)
+{
+	static KB kb({ { { 10, 0 }, { 11, 0 }, { 12, 0 } } });
+	static KB::event_queue<4> queue;
+	kb.attachQueue(&queue);
+	queue.clear();
+	kb.clear();
+	for (size_t k{}; k != 3; ++k) { kb.getKey(k).set(eState::idle, 0); }
+	kb.assignChord<2>(0, { 10, 11 }, eState::push);
+	kb.assign<1>(1, { 10 }, eState::release);
+	kb.assign<1>(2, { 11 }, eState::release);
+	kb.update();
+
+	CHECK(step(kb, 100, first_, eState::push, 100) == 0);
+	kb.getKey(first_).set(eState::delay, 100);
+	CHECK(step(kb, 120, last_, eState::push, 120) == 0x1);
+	CHECK(wait(kb, 125) == 0x1);  // Reported while the last key is pushed
+	KB::FiredEvent event{};
+	CHECK(queue.pop(event) and event.event_idx == 0 and event.state == eState::push and event.push_time == 120);
+	CHECK(!queue.pop(event));
+
+	// The first key acted as modifier: its own release binding stays silent
+	const uint32_t last_release{ last_ == 0 ? 0x2u : 0x4u };  // Event 1 for 10, 2 for 11
+	kb.getKey(last_).set(eState::delay, 120);
+	CHECK(step(kb, 130, first_, eState::release, 100) == 0);
+	CHECK(step(kb, 130, first_, eState::idle, 100) == 0);
+	CHECK(step(kb, 140, last_, eState::release, 120) == last_release);
+	CHECK(step(kb, 140, last_, eState::idle, 120) == 0);
+	kb.attachQueue(nullptr);
+}
+
+}  // namespace
+
+
+
+int main()
+{
+	CHECK(play(eState::push, 0, 1, 20) == 1);
+	CHECK(play(eState::push, 1, 0, 20) == 1);
+	CHECK(play(eState::release, 0, 1, 20) == 1);
+	CHECK(play(eState::release, 1, 0, 20) == 1);
+	CHECK(play(eState::push, 1, 0, 50) == 1);  // The window is inclusive
+	CHECK(play(eState::push, 0, 1, 51) == 0);  // Too far apart
+	CHECK(play(eState::push, 1, 0, 51) == 0);
+
+	checkTrigger(0, 1);
+	checkTrigger(1, 0);  // Completed by 10, which is not the primary key 11
+	return testResult();
+}
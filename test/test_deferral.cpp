@@ -0,0 +1,88 @@
+// Deferral: an ambiguous keybind (a prefix of a longer one) waits until the longer keybind
+// completes, the key is released or the resolve timeout passes.
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<3, 4, 2>;
+using eState = KB::eState;
+
+// Either key of an unordered chord may be held while the other completes it
+constexpr auto Chord_Keymap{ makeKeymap<3, 4, 2>({ 10, 11, 12 }, {
+	{ 0, { 10 }, eState::push },
+	{ 1, { 11 }, eState::push },
+	{ 2, { 10, 11 }, eState::push, true },
+	{ 3, { 12 }, eState::push },
+}) };
+static_assert(Chord_Keymap.ambiguous(0) and Chord_Keymap.ambiguous(1), "");
+static_assert(!Chord_Keymap.ambiguous(2) and !Chord_Keymap.ambiguous(3), "");
+
+}  // namespace
+
+
+
+int main()
+{
+	static KB kb({ { { 1, 0 }, { 2, 0 }, { 3, 0 } } });
+	kb.assign<1>(0, { 1 }, eState::push);     // Ambiguous: 1 is the modifier of event 1
+	kb.assign<2>(1, { 1, 2 }, eState::push);
+	kb.assign<1>(2, { 3 }, eState::push);
+	kb.assign<1>(3, { 1 }, eState::release);
+	kb.resolveTimeout(150);
+	kb.clock(now);
+	CHECK(wait(kb, 0) == 0);
+	CHECK(kb.nextDeadline() == KB::No_Deadline);
+
+	// Not ambiguous: reported at once
+	CHECK(step(kb, 0, 2, eState::push, 0) == 0x4);
+	CHECK(step(kb, 0, 2, eState::idle, 0) == 0);
+
+	// The longer keybind completes: only it is reported
+	CHECK(step(kb, 0, 0, eState::push, 0) == 0);
+	CHECK(kb.nextDeadline() == 150);  // The resolve timeout
+	kb.getKey(0).set(eState::hold, 0);
+	CHECK(step(kb, 10, 1, eState::push, 10) == 0x2);
+	kb.getKey(1).set(eState::idle, 10);
+	CHECK(step(kb, 20, 0, eState::idle, 0) == 0);
+	CHECK(kb.nextDeadline() == KB::No_Deadline);
+
+	// Released before the timeout: reported with the release
+	CHECK(step(kb, 100, 0, eState::push, 100) == 0);
+	CHECK(kb.nextDeadline() == 250);
+	CHECK(step(kb, 110, 0, eState::release, 100) == 0x9);
+	CHECK(step(kb, 110, 0, eState::idle, 100) == 0);
+
+	// Held past the timeout: reported once when it passes
+	CHECK(step(kb, 200, 0, eState::push, 200) == 0);
+	CHECK(step(kb, 250, 0, eState::hold, 200) == 0);
+	CHECK(wait(kb, 349) == 0);
+	CHECK(wait(kb, 350) == 0x1);
+	CHECK(wait(kb, 360) == 0);
+	CHECK(step(kb, 400, 0, eState::release, 200) == 0x8);
+	CHECK(step(kb, 400, 0, eState::idle, 200) == 0);
+
+	// Without timeout nothing is deferred
+	kb.resolveTimeout(0);
+	CHECK(step(kb, 500, 0, eState::push, 500) == 0x1);
+
+	// An unordered chord completed from either key overtakes the single key
+	static KB chord({ { { 10, 0 }, { 11, 0 }, { 12, 0 } } });
+	chord.clock(now);
+	chord.resolveTimeout(150);
+	chord.assign<1>(0, { 10 }, eState::push);
+	chord.assign<1>(1, { 11 }, eState::push);
+	chord.assignChord<2>(2, { 10, 11 }, eState::push);
+	for (size_t first{}; first != 2; ++first) {
+		const size_t second{ 1 - first };
+		const uint32_t t{ 1000 + static_cast<uint32_t>(first) * 1000 };
+		CHECK(step(chord, t, first, eState::push, t) == 0);  // Deferred
+		CHECK(chord.nextDeadline() == t + 150);
+		chord.getKey(first).set(eState::hold, t);
+		CHECK(step(chord, t + 20, second, eState::push, t + 20) == 0x4);
+		CHECK(wait(chord, t + 200) == 0x4);  // The single key was dropped
+		chord.getKey(first).set(eState::idle, t);
+		CHECK(step(chord, t + 300, second, eState::idle, t + 20) == 0);
+	}
+	return testResult();
+}
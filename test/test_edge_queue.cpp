@@ -0,0 +1,153 @@
+// Edge queue: the SPSC ring itself, and edges drained by update(), including a press and
+// its release queued for the same update, and keys that need several updates to read an edge.
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<3, 4, 2>;
+using eState = KB::eState;
+
+/// @brief A key without `edge()` that reads its pin in `update()` and debounces it:
+/// the level must be read by two updates before the key reports it.
+class SlowKey
+{
+public:
+	using eState = IPushButton::eState;
+
+	bool      bPin;      // The level of the pin, set by the test
+	uint8_t   nStable;   // Updates that read the pin at a level different from the state
+	eState    eCurrent;
+	uint32_t  nPushTime;
+	uint16_t  nId;
+
+	uint16_t id() const { return nId; }
+	eState state() const { return eCurrent; }
+	uint32_t pushTime() const { return nPushTime; }
+	void update()
+	{
+		const bool down{ (eCurrent & (eState::push | eState::hold)) != 0 };
+		if (bPin == down) {
+			nStable = 0;
+			if (eCurrent & eState::push) { eCurrent = eState::hold; }
+			return;
+		}
+		if (++nStable != 2) { return; }
+		nStable = 0;
+		eCurrent = bPin ? eState::push : eState::idle;
+		if (bPin) { nPushTime = gNow; }
+	}
+};
+
+/// @brief A keybind system over `SlowKey`s, assembled from `IKeybindCore` like `IKeybind`.
+class SlowKeybind final : public IKeybindCore<SlowKeybind, 2, 2, 1, SlowKey>,
+	public IKeybindKeymapOwner<IKeymap<2, 2, 1>>
+{
+	using base_type = IKeybindCore<SlowKeybind, 2, 2, 1, SlowKey>;
+	friend base_type;
+
+	std::array<SlowKey, 2> aKey;
+
+	std::array<SlowKey, 2>& keyArray() { return aKey; }
+	const std::array<SlowKey, 2>& keyArray() const { return aKey; }
+
+public:
+	SlowKeybind() :
+		base_type(),
+		aKey{ { { false, 0, eState::idle, 0, 10 }, { false, 0, eState::idle, 0, 11 } } }
+	{
+		this->indexKeyIds();
+	}
+};
+
+}  // namespace
+
+
+
+int main()
+{
+	// The ring: FIFO order, capacity, overflow count and wrap of the slot indices
+	{
+		static KB::edge_queue<3> ring;
+		KB::KeyEdge edge{};
+		CHECK(ring.capacity() == 3);
+		CHECK(ring.empty());
+		CHECK(!ring.pop(edge));
+		CHECK(!ring.peek(edge));
+		for (uint32_t round{}; round != 5; ++round) {
+			CHECK(ring.push({ 0, true, round * 10 + 1 }));
+			CHECK(ring.push({ 1, false, round * 10 + 2 }));
+			CHECK(ring.push({ 2, true, round * 10 + 3 }));
+			CHECK(!ring.push({ 0, false, round * 10 + 4 }));  // Full
+			CHECK(ring.peek(edge) and edge.time == round * 10 + 1);
+			CHECK(ring.pop(edge) and edge.key_idx == 0 and edge.level and edge.time == round * 10 + 1);
+			CHECK(ring.pop(edge) and edge.key_idx == 1 and !edge.level and edge.time == round * 10 + 2);
+			CHECK(ring.pop(edge) and edge.key_idx == 2 and edge.time == round * 10 + 3);
+			CHECK(!ring.pop(edge));
+		}
+		CHECK(ring.overflowCount() == 5);
+	}
+
+	// Same drain: a press and its release (and a tap on a tap-hold key) arrive before one update.
+	// Each update applies at most one edge per key, so the press is seen before the release.
+	{
+		static KB kb({ { { 10, 0 }, { 11, 0 }, { 12, 0 } } });
+		static KB::edge_queue<8> edges;
+		kb.attachEdgeQueue(&edges);
+		kb.clock(now);
+		kb.assign<1>(0, { 10 }, eState::push);
+		kb.assignTapHold(1, 2, 11);
+		kb.update();
+
+		CHECK(edges.push({ 0, true, 5 }));
+		CHECK(edges.push({ 0, false, 20 }));
+		CHECK(edges.push({ 1, true, 25 }));
+		CHECK(edges.push({ 1, false, 30 }));
+		CHECK(kb.nextDeadline() == 5);  // Queued edges are due
+		gNow = 40;
+		int push{}, tap{}, hold{};
+		for (int i{}; i != 4; ++i) {
+			kb.update();
+			push += kb.isEvent(0);
+			tap += kb.isEvent(1);
+			hold += kb.isEvent(2);
+		}
+		CHECK(push == 1);
+		CHECK(tap == 1);
+		CHECK(hold == 0);
+		CHECK(edges.empty());
+		CHECK(kb.getKey(0).state() == eState::idle);
+		CHECK(kb.getKey(1).state() == eState::idle);
+	}
+
+	// A key that cannot take the edge is scanned until it reads the press, or the settle time passed
+	{
+		static SlowKeybind kb;
+		static SlowKeybind::edge_queue<4> edges;
+		kb.attachEdgeQueue(&edges);
+		kb.clock(now);
+		kb.settleTime(50);
+		kb.assign<1>(0, { 10 }, eState::push);
+		CHECK(wait(kb, 0) == 0);
+
+		kb.getKey(0).bPin = true;
+		CHECK(edges.push({ 0, true, 100 }));
+		CHECK(wait(kb, 100) == 0);  // Debouncing
+		CHECK(kb.nextDeadline() <= 100);  // Still due
+		CHECK(wait(kb, 101) == 0x1);  // Woken by no edge, but still scanned
+		CHECK(kb.getKey(0).pushTime() == 101);
+
+		// A bounce that never reaches the key leaves the scan after the settle time
+		kb.getKey(1).bPin = true;
+		CHECK(edges.push({ 1, true, 200 }));
+		CHECK(wait(kb, 200) == 0);
+		kb.getKey(1).bPin = false;
+		CHECK(wait(kb, 210) == 0);
+		CHECK(wait(kb, 260) == 0);
+		kb.getKey(1).bPin = true;  // Not scanned without a new edge
+		wait(kb, 270);
+		wait(kb, 280);
+		CHECK(kb.getKey(1).state() == eState::idle);
+	}
+	return testResult();
+}
@@ -0,0 +1,74 @@
+// Event queue: every newly detected event is queued once with the state and push time of its
+// primary key; a full queue drops and counts.
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<3, 4, 2>;
+using eState = KB::eState;
+
+}  // namespace
+
+
+
+int main()
+{
+	// The ring: FIFO order across the end of the storage, overflow count
+	{
+		static KB::event_queue<3> ring;
+		KB::FiredEvent event{};
+		CHECK(ring.empty() and ring.capacity() == 3);
+		uint32_t pushed{}, popped{};
+		CHECK(ring.push({ 0, eState::push, pushed++ }));
+		CHECK(ring.push({ 1, eState::hold, pushed++ }));
+		for (int round{}; round != 5; ++round) {
+			CHECK(ring.push({ 2, eState::push, pushed++ }));
+			CHECK(ring.pop(event) and event.push_time == popped++);
+			CHECK(ring.push({ 3, eState::push, pushed++ }));
+			CHECK(!ring.push({ 3, eState::push, 99 }));  // Full
+			CHECK(ring.pop(event) and event.push_time == popped++);
+		}
+		CHECK(ring.size() == 2 and ring.overflowCount() == 5);
+		CHECK(ring.drain([&](const KB::FiredEvent& event_) { CHECK(event_.push_time == popped++); }) == 2);
+		CHECK(popped == pushed);
+		CHECK(ring.empty());
+	}
+
+	// Queued by update()
+	{
+		static KB kb({ { { 1, 0 }, { 2, 0 }, { 3, 0 } } });
+		static KB::event_queue<2> queue;
+		kb.attachQueue(&queue);
+		kb.assign<1>(0, { 1 }, eState::push);
+		kb.assign<2>(1, { 1, 2 }, eState::hold);
+		kb.assign<1>(2, { 3 }, eState::release);
+
+		CHECK(step(kb, 10, 0, eState::push, 10) == 0x1);
+		CHECK(step(kb, 20, 0, eState::push, 10) == 0x1);  // Still detected, not queued again
+		CHECK(queue.size() == 1);
+		kb.getKey(0).set(eState::hold, 10);
+		step(kb, 30, 1, eState::push, 30);
+		CHECK(step(kb, 40, 1, eState::hold, 30) == 0x2);
+		KB::FiredEvent event{};
+		CHECK(queue.pop(event) and event.event_idx == 0 and event.state == eState::push and event.push_time == 10);
+		CHECK(queue.pop(event) and event.event_idx == 1 and event.state == eState::hold and event.push_time == 30);
+		CHECK(!queue.pop(event));
+
+		// Not drained: the third event is dropped
+		step(kb, 50, 1, eState::idle, 30);
+		step(kb, 50, 0, eState::idle, 10);
+		step(kb, 60, 2, eState::release, 55);
+		step(kb, 70, 2, eState::idle, 55);
+		step(kb, 80, 2, eState::release, 75);
+		step(kb, 90, 2, eState::idle, 75);
+		step(kb, 100, 2, eState::release, 95);
+		CHECK(queue.size() == 2 and queue.overflowCount() == 1);
+		CHECK(queue.pop(event) and event.event_idx == 2 and event.state == eState::release and event.push_time == 55);
+		kb.attachQueue(nullptr);
+		step(kb, 110, 2, eState::idle, 95);
+		step(kb, 120, 2, eState::release, 115);
+		CHECK(queue.size() == 1);
+	}
+	return testResult();
+}
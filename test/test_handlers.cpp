@@ -0,0 +1,70 @@
+// Event handlers: called once when an event is detected, with their context or object;
+// replaced, removed and range-checked like the rest of the API.
+#include <stdexcept>
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<3, 4, 2>;
+using eState = KB::eState;
+
+struct Menu
+{
+	int selected{};
+	uint32_t last_push{};
+
+	void select(const KB::FiredEvent& event_)
+	{
+		++selected;
+		last_push = event_.push_time;
+	}
+};
+
+void countInto(void* ctx_, const KB::FiredEvent&) { ++*static_cast<int*>(ctx_); }
+
+}  // namespace
+
+
+
+int main()
+{
+	static KB kb({ { { 1, 0 }, { 2, 0 }, { 3, 0 } } });
+	kb.assign<1>(0, { 1 }, eState::push);
+	kb.assign<1>(1, { 2 }, eState::push);
+	kb.assign<1>(2, { 3 }, eState::push);
+	int calls{};
+	Menu menu;
+	kb.onEvent(0, countInto, &calls);
+	kb.onEvent<Menu, &Menu::select>(1, menu);
+	kb.onEvent(2, count<KB::FiredEvent>);
+
+	CHECK(step(kb, 10, 0, eState::push, 10) == 0x1);
+	CHECK(step(kb, 20, 0, eState::push, 10) == 0x1);  // Still detected: no second call
+	CHECK(calls == 1);
+	step(kb, 30, 0, eState::idle, 10);
+	tap(kb, 1, 40);
+	CHECK(menu.selected == 1 and menu.last_push == 40);
+	tap(kb, 2, 50);
+	tap(kb, 2, 60);
+	CHECK(gFired[2] == 2);
+
+	// Replaced and removed
+	kb.onEvent(1, countInto, &calls);
+	kb.onEvent(2, nullptr);
+	tap(kb, 1, 70);
+	CHECK(tap(kb, 2, 80) == 0x4);  // Still reported by isEvent()
+	CHECK(calls == 2 and menu.selected == 1 and gFired[2] == 2);
+
+	// Handlers survive clear()
+	kb.clear();
+	kb.assign<1>(1, { 3 }, eState::push);
+	tap(kb, 2, 90);
+	CHECK(calls == 3);
+
+	bool thrown{ false };
+	try { kb.onEvent(4, countInto, &calls); }
+	catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	return testResult();
+}
@@ -0,0 +1,38 @@
+// Key IDs: sparse, unsorted 16-bit IDs resolve to their key index through the sorted table.
+#include <stdexcept>
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<5, 5, 2>;
+using eState = KB::eState;
+
+}  // namespace
+
+
+
+int main()
+{
+	static KB kb({ { { 900, 0 }, { 3, 0 }, { 65535, 0 }, { 40, 0 }, { 0, 0 } } });
+	kb.assign<1>(0, { 65535 }, eState::push);
+	kb.assign<1>(1, { 0 }, eState::push);
+	kb.assign<2>(2, { 900, 3 }, eState::push);
+	kb.assign<1>(3, { 40 }, eState::push);
+	kb.assign<1>(4, { 900 }, eState::push);
+
+	CHECK(tap(kb, 2, 10) == 0x01);
+	CHECK(tap(kb, 4, 20) == 0x02);
+	CHECK(tap(kb, 3, 30) == 0x08);
+	CHECK(tap(kb, 0, 40) == 0x10);
+	kb.getKey(0).set(eState::hold, 40);
+	CHECK(tap(kb, 1, 50) == 0x04);
+
+	bool thrown{ false };
+	try { kb.assign<2>(0, { 3, 41 }, eState::push); }
+	catch (const std::invalid_argument&) { thrown = true; }
+	CHECK(thrown);
+	CHECK(step(kb, 60, 0, eState::idle, 40) == 0);
+	CHECK(tap(kb, 2, 70) == 0x01);  // The failed assign kept the old keybind
+	return testResult();
+}
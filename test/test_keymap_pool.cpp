@@ -0,0 +1,96 @@
+// Keymap pool: set() packs the sequences back to back and moves the ones behind the edited
+// event; a pooled keybind system detects the same events as one that reserves KbMax keys.
+#include <stdexcept>
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using eState = IPushButton::eState;
+
+}  // namespace
+
+
+
+int main()
+{
+	// Grow, shrink and clear sequences in the middle of the pool
+	{
+		static IKeymap<6, 4, 3, 6> map;
+		map.set(0, { 0, 1 }, 2, eState::push);
+		map.set(1, { 2 }, 1, eState::push);
+		map.set(2, { 3, 4, 5 }, 3, eState::push);
+		CHECK(!map.fits(3, 1));  // Pool full
+		CHECK(map.fits(1, 1));   // Replacing the keybind of event 1
+		map.set(1, {}, 0, eState::none);
+		map.set(3, { 5 }, 1, eState::release);
+		CHECK(map.size(0) == 2 and map.size(1) == 0 and map.size(2) == 3 and map.size(3) == 1);
+		CHECK(map.keyIdx(0, 0) == 1 and map.keyIdx(0, 1) == 0);  // Primary key first
+		CHECK(map.keyIdx(2, 0) == 5 and map.keyIdx(2, 1) == 4 and map.keyIdx(2, 2) == 3);
+		CHECK(map.keyIdx(3, 0) == 5);
+		map.set(0, { 2 }, 1, eState::hold);
+		CHECK(map.size(0) == 1 and map.keyIdx(0, 0) == 2);
+		CHECK(map.keyIdx(2, 0) == 5 and map.keyIdx(2, 2) == 3 and map.keyIdx(3, 0) == 5);
+		CHECK(map.fits(1, 1) and !map.fits(1, 2));
+	}
+
+	// A full pool rejects the assignment and keeps the old keybind
+	{
+		using KB = IKeybind<4, 3, 3, 4>;
+		static KB kb({ { { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 } } });
+		kb.assign<3>(0, { 1, 2, 3 }, eState::push);
+		bool thrown{ false };
+		try { kb.assign<2>(1, { 1, 4 }, eState::push); }
+		catch (const std::out_of_range&) { thrown = true; }
+		CHECK(thrown);
+		kb.assign<1>(1, { 4 }, eState::push);
+		kb.assign<2>(0, { 1, 2 }, eState::push);  // Frees a key of the pool
+		kb.assign<1>(2, { 3 }, eState::push);
+
+		kb.getKey(0).set(eState::hold, 0);
+		kb.getKey(1).set(eState::push, 10);
+		kb.update();
+		CHECK(kb.isEvent(0) and !kb.isEvent(1) and !kb.isEvent(2));
+		kb.getKey(1).set(eState::hold, 10);
+		kb.getKey(3).set(eState::push, 20);
+		kb.update();
+		CHECK(!kb.isEvent(0) and kb.isEvent(1) and !kb.isEvent(2));
+	}
+
+	// Reassigning in any order gives the same events with and without pool
+	{
+		std::array<IPushButton, 4> keys{ { { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 } } };
+		static IKeybind<4, 4, 3> plain(keys);
+		static IKeybind<4, 4, 3, 8> pooled(keys);
+		auto assign = [](auto& kb_) {
+			kb_.template assign<3>(0, { 1, 2, 3 }, eState::push);
+			kb_.template assign<2>(1, { 2, 4 }, eState::push);
+			kb_.template assign<1>(2, { 4 }, eState::release);
+			kb_.template assign<1>(0, { 3 }, eState::push);
+			kb_.template assign<3>(1, { 1, 2, 4 }, eState::push);
+			kb_.template assign<2>(3, { 1, 3 }, eState::push);
+		};
+		assign(plain);
+		assign(pooled);
+		const struct { size_t key; eState state; } script[]{
+			{ 0, eState::push }, { 0, eState::hold }, { 1, eState::push }, { 1, eState::hold },
+			{ 3, eState::push }, { 3, eState::release }, { 3, eState::idle }, { 2, eState::push },
+			{ 2, eState::idle }, { 1, eState::idle }, { 2, eState::push }, { 0, eState::idle },
+		};
+		int fired{};
+		uint32_t t{};
+		for (const auto& step : script) {
+			t += 10;
+			plain.getKey(step.key).set(step.state, t);
+			pooled.getKey(step.key).set(step.state, t);
+			plain.update();
+			pooled.update();
+			for (size_t e{}; e != 4; ++e) {
+				CHECK(plain.isEvent(e) == pooled.isEvent(e));
+				fired += plain.isEvent(e);
+			}
+		}
+		CHECK(fired == 4);  // 1+2+4, release of 4, then 1+3 twice
+	}
+	return testResult();
+}
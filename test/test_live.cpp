@@ -0,0 +1,44 @@
+// Live remapping: edits go to a staging keymap and take effect at the first update() after
+// publish(); edits while a keymap waits to be swapped in are refused.
+#include <stdexcept>
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybindLive<3, 3, 2>;
+using eState = KB::eState;
+
+}  // namespace
+
+
+
+int main()
+{
+	static KB kb({ { { 1, 0 }, { 2, 0 }, { 3, 0 } } });
+	kb.assign<1>(0, { 1 }, eState::push);
+	CHECK(tap(kb, 0, 10) == 0);  // Not published yet
+	kb.publish();
+	CHECK(kb.pending());
+	bool thrown{ false };
+	try { kb.assign<1>(1, { 2 }, eState::push); }
+	catch (const std::logic_error&) { thrown = true; }
+	CHECK(thrown);
+	CHECK(tap(kb, 0, 20) == 0x1);
+	CHECK(!kb.pending());
+
+	// The staging keymap starts from the published one
+	kb.assign<1>(1, { 2 }, eState::push);
+	CHECK(tap(kb, 1, 30) == 0);
+	kb.publish();
+	CHECK(tap(kb, 1, 40) == 0x2);
+	CHECK(tap(kb, 0, 50) == 0x1);
+
+	kb.clear();
+	kb.assign<1>(2, { 3 }, eState::push);
+	CHECK(tap(kb, 0, 60) == 0x1);  // The old keymap stays in use until published
+	kb.publish();
+	CHECK(tap(kb, 0, 70) == 0);
+	CHECK(tap(kb, 2, 80) == 0x4);
+	return testResult();
+}
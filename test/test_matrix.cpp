@@ -0,0 +1,92 @@
+// Key matrix: debounced presses, hold and release drive the keybind engine; columns beyond
+// NCol are ignored, and misuse of the port and of update() throws.
+#include <stdexcept>
+#include "IKeyMatrix.h"
+#include "check.h"
+
+namespace {
+
+using Port = IKeyMatrixPortSim<2, 6>;
+using KB = IKeybindMatrix<Port, 2, 6, 4, 2>;
+using eState = KB::eState;
+
+/// @brief A port whose row 0 reads two columns past the matrix besides column 0.
+struct WidePort
+{
+	using word_type = uint8_t;
+	uint8_t row{ 2 };
+	void selectRow(uint8_t row_) { row = row_; }
+	void unselectRow(uint8_t) { row = 2; }
+	word_type readColumns() const { return row == 0 ? 0xC1 : 0; }
+};
+
+}  // namespace
+
+
+
+int main()
+{
+	static Port port;
+	static KB kb(port, 300);
+	kb.assign<1>(0, { 7 }, eState::push);     // Row 1, column 1
+	kb.assign<1>(1, { 7 }, eState::hold);
+	kb.assign<1>(2, { 7 }, eState::release);
+	kb.assign<2>(3, { 0, 7 }, eState::push);  // Row 0, column 0 as modifier
+
+	bool thrown{ false };
+	try { kb.update(); }
+	catch (const std::logic_error&) { thrown = true; }
+	CHECK(thrown);
+	kb.clock(now);
+	for (size_t e{}; e != 4; ++e) { kb.onEvent(e, count<KB::FiredEvent>); }
+
+	// Debounced: the level must be read 4 scans in a row
+	auto step = [](uint32_t dt_) {
+		gNow += dt_;
+		kb.update();
+	};
+	step(10);
+	port.press(1, 1);
+	step(10);
+	step(10);
+	step(10);
+	CHECK(kb.getKey(7).state() == eState::idle);
+	step(10);
+	CHECK(kb.getKey(7).state() == eState::push);
+	CHECK(gFired[0] == 1);
+	step(299);
+	CHECK(kb.getKey(7).state() == eState::push);
+	step(1);
+	CHECK(kb.getKey(7).state() == eState::hold);
+	CHECK(gFired[1] == 1);
+	port.release(1, 1);
+	for (int i{}; i != 4; ++i) { step(10); }
+	CHECK(kb.getKey(7).state() == eState::release);
+	step(10);
+	CHECK(kb.getKey(7).state() == eState::idle);
+	CHECK(gFired[0] == 1 and gFired[1] == 1 and gFired[2] == 1 and gFired[3] == 0);
+
+	// With the modifier down, the longer keybind wins
+	port.press(0, 0);
+	for (int i{}; i != 4; ++i) { step(10); }
+	port.press(1, 1);
+	for (int i{}; i != 4; ++i) { step(10); }
+	CHECK(gFired[0] == 1 and gFired[3] == 1);
+
+	// Only the NCol low bits of a column word are keys
+	static WidePort wide;
+	static IKeyMatrix<WidePort, 2, 6> matrix(wide);
+	for (uint32_t t{}; t != 6; ++t) { matrix.scan(t); }
+	CHECK(matrix.levels().test(0));
+	CHECK(matrix.levels().findNext(1) == 12);
+
+	thrown = false;
+	try { port.press(0, 6); }
+	catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	thrown = false;
+	try { port.release(2, 0); }
+	catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	return testResult();
+}
@@ -0,0 +1,44 @@
+// Pattern automaton: patterns found anywhere in the stream of presses, overlapping and nested.
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<4, 8>;
+using eState = KB::eState;
+
+}  // namespace
+
+
+
+int main()
+{
+	static KB kb({ { { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 } } });
+	static KB::pattern<16> codes;
+	kb.attachPattern(&codes);
+	kb.assignPattern<3>(0, { 1, 2, 3 });  // 1 2 3
+	kb.assignPattern<2>(1, { 2, 3 });     // 2 3, a suffix of 1 2 3
+	kb.assignPattern<3>(2, { 1, 1, 2 });  // 1 1 2
+
+	uint32_t t{};
+	CHECK(tap(kb, 3, t += 10) == 0);
+	CHECK(tap(kb, 0, t += 10) == 0);
+	CHECK(tap(kb, 1, t += 10) == 0);
+	CHECK(tap(kb, 2, t += 10) == 0x03);  // 1 2 3 and its suffix 2 3
+	CHECK(tap(kb, 0, t += 10) == 0);
+	CHECK(tap(kb, 0, t += 10) == 0);
+	CHECK(tap(kb, 0, t += 10) == 0);
+	CHECK(tap(kb, 1, t += 10) == 0x04);  // 1 1 1 2 ends with 1 1 2
+	CHECK(tap(kb, 2, t += 10) == 0x03);  // 1 1 1 2 3 ends with 1 2 3 again
+
+	// A branch added to an inner node after the links were built
+	kb.assignPattern<3>(3, { 1, 2, 4 });  // 1 2 4
+	CHECK(tap(kb, 0, t += 10) == 0);
+	CHECK(tap(kb, 0, t += 10) == 0);
+	CHECK(tap(kb, 1, t += 10) == 0x04);
+	CHECK(tap(kb, 3, t += 10) == 0x08);  // 1 1 2 4 ends with 1 2 4
+	CHECK(tap(kb, 0, t += 10) == 0);
+	CHECK(tap(kb, 1, t += 10) == 0);
+	CHECK(tap(kb, 2, t += 10) == 0x03);
+	return testResult();
+}
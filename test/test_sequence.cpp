@@ -0,0 +1,60 @@
+// Sequence trie: steps detected one after another, timeouts, restarts and capacity.
+#include <stdexcept>
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<3, 8>;
+using eState = KB::eState;
+
+}  // namespace
+
+
+
+int main()
+{
+	static KB kb({ { { 1, 0 }, { 2, 0 }, { 3, 0 } } });
+	static KB::sequence<8> seq;
+	kb.attachSequence(&seq);
+	seq.timeout(100);
+	kb.assign<1>(0, { 1 }, eState::push);
+	kb.assign<1>(1, { 2 }, eState::push);
+	kb.assign<1>(2, { 3 }, eState::push);
+	kb.assignSequence<2>(5, { 0, 1 });     // A B
+	kb.assignSequence<3>(6, { 0, 1, 2 });  // A B C
+	kb.assignSequence<2>(7, { 1, 1 });     // B B
+
+	CHECK(tap(kb, 0, 10) == 0x01);
+	CHECK(tap(kb, 1, 20) == 0x22);  // A B completes 5
+	CHECK(tap(kb, 2, 30) == 0x44);  // A B C completes 6
+	CHECK(tap(kb, 0, 100) == 0x01);
+	CHECK(tap(kb, 1, 300) == 0x02);  // Timed out
+	CHECK(tap(kb, 1, 310) == 0x82);  // B B
+	CHECK(tap(kb, 0, 400) == 0x01);
+	CHECK(tap(kb, 2, 410) == 0x04);  // Mismatch restarts
+	CHECK(tap(kb, 0, 420) == 0x01);
+	CHECK(tap(kb, 1, 430) == 0x22);
+	CHECK(seq.size() == 6);
+
+	// A branch added to an inner node after later nodes moves their edges
+	kb.assignSequence<2>(3, { 0, 2 });     // A C
+	CHECK(tap(kb, 0, 500) == 0x01);
+	CHECK(tap(kb, 2, 510) == 0x0C);
+	CHECK(tap(kb, 0, 520) == 0x01);
+	CHECK(tap(kb, 1, 530) == 0x22);
+	CHECK(tap(kb, 2, 540) == 0x44);
+	CHECK(tap(kb, 1, 550) == 0x02);
+	CHECK(tap(kb, 1, 560) == 0x82);
+	CHECK(seq.size() == 7);
+
+	bool thrown{ false };
+	try { kb.assignSequence<4>(4, { 2, 2, 2, 2 }); }
+	catch (const std::out_of_range&) { thrown = true; }
+	CHECK(thrown);
+	CHECK(seq.size() == 7);  // A failed insert leaves the trie unchanged
+
+	kb.clear();
+	CHECK(seq.size() == 1);
+	return testResult();
+}
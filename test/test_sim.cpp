@@ -0,0 +1,79 @@
+// Virtual-time replay: the same script gives the same events, updates follow the edges and
+// deadlines instead of the poll period, and edges reach the keys with their scripted times.
+#include <vector>
+#include "IKeybindSim.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<4, 4, 2>;
+using Sim = IKeybindSim<KB>;
+using eState = KB::eState;
+
+struct Log
+{
+	std::vector<KB::FiredEvent> events;
+
+	void onEvent(const KB::FiredEvent& event_) { events.push_back(event_); }
+};
+
+/// @brief Replays the script from `start_` for `duration_` and logs the reported events.
+size_t replay(const std::vector<KB::KeyEdge>& script_, uint32_t start_, uint32_t duration_, Log& log_)
+{
+	static KB kb({ { { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 } } });
+	kb.clear();
+	for (size_t k{}; k != 4; ++k) { kb.getKey(k).set(eState::idle, start_); }
+	kb.assign<1>(0, { 1 }, eState::push);
+	kb.assign<2>(1, { 1, 2 }, eState::push);
+	kb.assign<1>(2, { 3 }, eState::release);
+	kb.resolveTimeout(100);
+	for (size_t e{}; e != 4; ++e) { kb.onEvent<Log, &Log::onEvent>(e, log_); }
+
+	Sim sim(kb, start_, 5);
+	sim.play(script_.data(), script_.size());
+	sim.runUntil(start_ + duration_);
+	CHECK(sim.finished());
+	CHECK(sim.now() == start_ + duration_);
+	for (size_t e{}; e != 4; ++e) { kb.onEvent(e, nullptr); }
+	return sim.updateCount();
+}
+
+}  // namespace
+
+
+
+int main()
+{
+	const uint32_t start{ 1000 };
+	const std::vector<KB::KeyEdge> script{
+		{ 0, true, start + 100 }, { 0, false, start + 150 },    // 1 alone: deferred, reported at the release
+		{ 0, true, start + 400 }, { 1, true, start + 420 },     // 1 then 2: the longer keybind
+		{ 1, false, start + 480 }, { 0, false, start + 500 },
+		{ 0, true, start + 1000 },                              // 1 held: reported at the timeout
+		{ 0, false, start + 1500 },
+		{ 2, true, start + 60000 }, { 2, false, start + 60050 },  // A minute later
+	};
+	const uint32_t duration{ 120000 };
+
+	Log log[2];
+	const size_t updates[2]{ replay(script, start, duration, log[0]), replay(script, start, duration, log[1]) };
+	CHECK(updates[0] == updates[1]);
+	CHECK(log[0].events.size() == log[1].events.size());
+	for (size_t i{}; i != log[0].events.size() and i != log[1].events.size(); ++i) {
+		CHECK(log[0].events[i].event_idx == log[1].events[i].event_idx);
+		CHECK(log[0].events[i].push_time == log[1].events[i].push_time);
+	}
+
+	// 0 at 150, 1 at 420, 0 at 1100, 2 at 60050
+	CHECK(log[0].events.size() == 4);
+	if (log[0].events.size() == 4) {
+		CHECK(log[0].events[0].event_idx == 0 and log[0].events[0].push_time == start + 100);
+		CHECK(log[0].events[1].event_idx == 1 and log[0].events[1].push_time == start + 420);
+		CHECK(log[0].events[2].event_idx == 0 and log[0].events[2].push_time == start + 1000);
+		CHECK(log[0].events[3].event_idx == 2 and log[0].events[3].push_time == start + 60000);
+	}
+
+	// Polling every 5 units would take 24000 updates
+	CHECK(updates[0] < 50);
+	return testResult();
+}
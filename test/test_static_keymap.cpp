@@ -0,0 +1,43 @@
+// Compile-time keymap: the keys must have the IDs the keymap was built for, in the same order.
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using eState = IPushButton::eState;
+
+constexpr auto Keymap{ makeKeymap<3, 4, 2>({ 10, 11, 12 }, {
+	{ 0, { 10 }, eState::push },
+	{ 1, { 10, 11 }, eState::push },
+	{ 2, { 12 }, eState::release },
+}) };
+
+}  // namespace
+
+
+
+int main()
+{
+	static_assert(Keymap.size(0) == 1 and Keymap.size(1) == 2 and Keymap.size(2) == 1, "");
+	static_assert(Keymap.keyId(0) == 10 and Keymap.keyId(2) == 12, "");
+
+	// Built at run time, a definition with an unknown key is dropped instead of failing the build
+	const auto runtime{ makeKeymap<3, 4, 2>({ 10, 11, 12 }, { { 0, { 10 }, eState::push }, { 3, { 12, 99 }, eState::push } }) };
+	CHECK(runtime.size(0) == 1 and runtime.size(3) == 0);
+
+	std::array<IPushButton, 3> keys{ { { 10, 0 }, { 11, 0 }, { 12, 0 } } };
+	static IKeybindStatic<Keymap> kb(keys);
+	kb.getKey(0).set(eState::hold, 0);
+	kb.getKey(1).set(eState::push, 10);
+	kb.update();
+	CHECK(!kb.isEvent(0) and kb.isEvent(1));
+	kb.getKey(2).set(eState::release, 20);
+	kb.update();
+	CHECK(kb.isEvent(2) and !kb.isEvent(3));
+
+	CHECK(kb.valid());
+	std::array<IPushButton, 3> reordered{ { { 12, 0 }, { 11, 0 }, { 10, 0 } } };
+	static IKeybindStatic<Keymap> bad(reordered);
+	CHECK(!bad.valid());
+	return testResult();
+}
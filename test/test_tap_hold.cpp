@@ -0,0 +1,61 @@
+// Tap-hold: a key reports its tap event when released within the tapping term, and its hold
+// event when held past it or when another key is pushed while it is down.
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<3, 6, 2>;
+using eState = KB::eState;
+
+}  // namespace
+
+
+
+int main()
+{
+	static KB kb({ { { 1, 0 }, { 2, 0 }, { 3, 0 } } });
+	kb.assignTapHold(0, 1, 1);               // Key 1: tap 0, hold 1
+	kb.assign<2>(2, { 1, 2 }, eState::push);
+	kb.assign<1>(3, { 3 }, eState::push);
+	kb.clock(now);
+	kb.tappingTerm(200);
+	for (size_t e{}; e != 6; ++e) { kb.onEvent(e, count<KB::FiredEvent>); }
+	CHECK(wait(kb, 0) == 0);
+
+	// Tap
+	CHECK(step(kb, 0, 0, eState::push, 0) == 0);
+	CHECK(step(kb, 50, 0, eState::delay, 0) == 0);
+	CHECK(step(kb, 80, 0, eState::release, 0) == 0x1);
+	CHECK(step(kb, 80, 0, eState::idle, 0) == 0);
+
+	// Held past the tapping term
+	CHECK(step(kb, 100, 0, eState::push, 100) == 0);
+	CHECK(kb.nextDeadline() == 300);  // The tapping term
+	CHECK(step(kb, 299, 0, eState::delay, 100) == 0);
+	CHECK(wait(kb, 300) == 0x2);
+	CHECK(wait(kb, 350) == 0x2);  // Stays reported while held
+	CHECK(step(kb, 350, 0, eState::release, 100) == 0);  // No tap
+	CHECK(step(kb, 350, 0, eState::idle, 100) == 0);
+	CHECK(gFired[0] == 1 and gFired[1] == 1);
+
+	// Another key pushed while down: hold at once (permissive hold)
+	CHECK(step(kb, 400, 0, eState::push, 400) == 0);
+	kb.getKey(0).set(eState::delay, 400);
+	CHECK(step(kb, 420, 2, eState::push, 420) == 0xA);
+	kb.getKey(2).set(eState::idle, 420);
+	CHECK(step(kb, 440, 0, eState::release, 400) == 0);
+	CHECK(step(kb, 440, 0, eState::idle, 400) == 0);
+
+	// Used as the modifier of a keybind
+	CHECK(step(kb, 500, 0, eState::push, 500) == 0);
+	kb.getKey(0).set(eState::delay, 500);
+	CHECK(step(kb, 510, 1, eState::push, 510) == 0x6);
+	kb.getKey(1).set(eState::idle, 510);
+	CHECK(step(kb, 510, 0, eState::release, 500) == 0);
+	CHECK(step(kb, 510, 0, eState::idle, 500) == 0);
+	CHECK(kb.nextDeadline() == KB::No_Deadline);
+
+	CHECK(gFired[0] == 1 and gFired[1] == 3 and gFired[2] == 1 and gFired[3] == 1);
+	return testResult();
+}
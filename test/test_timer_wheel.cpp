@@ -0,0 +1,124 @@
+// Timer wheel: timers expire exactly when a model says so, and next() is the earliest armed
+// expiry, also when the clock (and the tick count) wraps. A keybind system replayed across
+// the wrap reports the same events with and without the wheel.
+#include <random>
+#include <vector>
+#include "IKeybindSim.h"
+#include "check.h"
+
+namespace {
+
+using KB = IKeybind<8, 8, 2>;
+using eState = KB::eState;
+using Wheel = KB::timer_wheel<8, 2>;  // 8 slots of 4 time units: one revolution is 32
+
+bool isBefore(uint32_t a_, uint32_t b_) { return static_cast<int32_t>(a_ - b_) < 0; }
+
+/// @brief Schedules random timers around a clock that starts at `start_` and compares every
+/// `expire()` and `next()` with a list of the armed expiries.
+void checkWheel(uint32_t start_)
+{
+	static Wheel wheel;
+	std::mt19937 rng{ 3 };
+	bool armed[8]{};
+	uint32_t expiry[8]{};
+	uint32_t now{ start_ };
+	wheel.expire(now, [](size_t) {});
+	for (size_t k{}; k != 8; ++k) { wheel.cancel(static_cast<uint8_t>(k)); }
+	int wrong{};
+	for (int step{}; step != 20000; ++step) {
+		now += 1 + rng() % (step % 7 ? 12 : 90);  // Sometimes more than a revolution
+		if (rng() % 2) {
+			const uint8_t k{ static_cast<uint8_t>(rng() % 8) };
+			expiry[k] = now - 8 + rng() % 120;  // Some are overdue, some a few revolutions ahead
+			armed[k] = true;
+			wheel.schedule(k, expiry[k]);
+		}
+		bool fired[8]{};
+		wheel.expire(now, [&](size_t k_) { fired[k_] = true; });
+		for (size_t k{}; k != 8; ++k) {
+			const bool due{ armed[k] and !isBefore(now, expiry[k]) };
+			wrong += fired[k] != due;
+			wrong += wheel.armed(static_cast<uint8_t>(k)) != (armed[k] and !due);
+			armed[k] = armed[k] and !due;
+		}
+		uint32_t earliest{ Wheel::No_Timer };
+		bool any{ false };
+		for (size_t k{}; k != 8; ++k) {
+			if (armed[k] and (!any or isBefore(expiry[k], earliest))) { earliest = expiry[k]; any = true; }
+		}
+		wrong += wheel.next() != earliest;
+	}
+	CHECK(wrong == 0);
+}
+
+/// @brief Generates taps on random keys, starting at `start_`, sorted by time.
+std::vector<KB::KeyEdge> makeScript(uint32_t start_)
+{
+	std::mt19937 rng{ 11 };
+	std::vector<KB::KeyEdge> script;
+	uint32_t t{ start_ };
+	for (int i{}; i != 200; ++i) {
+		const uint8_t k{ static_cast<uint8_t>(rng() % 8) };
+		t += 1 + rng() % 30;
+		script.push_back({ k, true, t });
+		t += 1 + rng() % 30;
+		script.push_back({ k, false, t });
+	}
+	return script;
+}
+
+/// @brief Hashes every reported event with its push time.
+void hashEvent(void* hash_, const KB::FiredEvent& event_)
+{
+	uint32_t& hash{ *static_cast<uint32_t*>(hash_) };
+	hash = hash * 31 + static_cast<uint32_t>(event_.event_idx) * 7 + event_.push_time;
+}
+
+/// @brief Replays the script and returns a hash of the reported events.
+uint32_t replay(const std::vector<KB::KeyEdge>& script_, uint32_t start_, bool wheel_, size_t& updates_)
+{
+	static KB kb({ { { 0, 0 }, { 1, 0 }, { 2, 0 }, { 3, 0 }, { 4, 0 }, { 5, 0 }, { 6, 0 }, { 7, 0 } } });
+	static Wheel wheel;
+	kb.clear();
+	for (size_t k{}; k != 8; ++k) { kb.getKey(k).set(eState::idle, start_); }
+	kb.assign<1>(0, { 0 }, eState::push);
+	kb.assign<1>(1, { 1 }, eState::release);
+	kb.assign<2>(2, { 2, 3 }, eState::push);
+	kb.assign<1>(3, { 3 }, eState::push);
+	kb.assign<2>(4, { 4, 5 }, eState::release);
+	kb.assign<1>(5, { 6 }, eState::push);
+	kb.assign<1>(6, { 7 }, eState::release);
+	kb.assignTapHold(7, 3, 2);
+	kb.resolveTimeout(40);
+	kb.tappingTerm(25);
+
+	IKeybindSim<KB> sim(kb, start_, 5);
+	kb.attachTimerWheel(wheel_ ? &wheel : nullptr);
+	uint32_t hash{};
+	for (size_t e{}; e != 8; ++e) { kb.onEvent(e, hashEvent, &hash); }
+	sim.play(script_.data(), script_.size());
+	while (!sim.finished() or kb.nextDeadline() != KB::No_Deadline) { sim.runUntil(sim.now() + 50); }
+	kb.attachTimerWheel(nullptr);
+	updates_ = sim.updateCount();
+	return hash;
+}
+
+}  // namespace
+
+
+
+int main()
+{
+	checkWheel(0);
+	checkWheel(0xFFFFFF00u);  // The clock and the 30-bit tick count wrap
+
+	for (const uint32_t start : { 0u, 0xFFFFFF00u }) {
+		const std::vector<KB::KeyEdge> script{ makeScript(start) };
+		size_t updates[2]{};
+		CHECK(replay(script, start, false, updates[0]) == replay(script, start, true, updates[1]));
+		CHECK(updates[0] == updates[1]);
+		CHECK(updates[0] > 0);
+	}
+	return testResult();
+}
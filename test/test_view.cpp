@@ -0,0 +1,46 @@
+// Views: keybind systems over caller-owned keys see the same key objects; only the one
+// that updates the keys advances them, so every key is updated once per cycle.
+#include "IKeybind.h"
+#include "check.h"
+
+namespace {
+
+using View = IKeybindView<3, 2, 2>;
+using eState = View::eState;
+
+}  // namespace
+
+
+
+int main()
+{
+	static std::array<IPushButton, 3> keys{ { { 1, 0 }, { 2, 0 }, { 3, 0 } } };
+	static View owner(keys);         // Updates the keys
+	static View mode(keys, false);   // Only reads them
+	owner.assign<1>(0, { 1 }, eState::push);
+	owner.assign<2>(1, { 1, 2 }, eState::release);
+	mode.assign<1>(0, { 1 }, eState::release);
+	mode.assign<1>(1, { 3 }, eState::push);
+
+	auto update = [] { owner.update(); mode.update(); };
+	keys[0].set(eState::push, 10);
+	update();
+	CHECK(owner.isEvent(0) and !mode.isEvent(0));
+	CHECK(&owner.getKey(0) == &keys[0] and &mode.getKey(0) == &keys[0]);
+
+	// The mock keeps a release for one key update per cycle: had `mode` updated the keys too,
+	// the key would be idle before `mode` read it
+	keys[0].set(eState::release, 10);
+	update();
+	CHECK(mode.isEvent(0));
+	update();
+	CHECK(keys[0].state() == eState::idle);
+	CHECK(!mode.isEvent(0));
+
+	keys[0].set(eState::hold, 40);
+	keys[1].set(eState::release, 50);
+	keys[2].set(eState::push, 50);
+	update();
+	CHECK(owner.isEvent(1) and mode.isEvent(1) and !owner.isEvent(0));
+	return testResult();
+}